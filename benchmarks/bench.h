@@ -0,0 +1,214 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_BENCH_H
+#define CSYS_BENCH_H
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    using BenchmarkFn = void (*)();    //!< Benchmark entry point
+
+    /*!
+     * \brief
+     *      Registered benchmarks
+     * \return
+     *      Name and entry point of every benchmark
+     */
+    inline std::vector<std::pair<const char *, BenchmarkFn>> &Registry()
+    {
+        static std::vector<std::pair<const char *, BenchmarkFn>> s_Registry;
+        return s_Registry;
+    }
+
+    /*!
+     * \brief
+     *      One reported measurement
+     */
+    struct Result
+    {
+        std::string m_Group;          //!< Benchmark that reported it
+        std::string m_Name;           //!< Name of the measurement
+        double m_Value;               //!< Measured value
+        std::string m_Unit;           //!< Unit of m_Value
+        double m_AllocsPerOp;         //!< Heap allocations per operation (Negative if not measured)
+        double m_BytesPerOp;          //!< Heap bytes allocated per operation (Negative if not measured)
+    };
+
+    /*!
+     * \brief
+     *      Every measurement reported so far
+     * \return
+     *      Results in report order
+     */
+    inline std::vector<Result> &Results()
+    {
+        static std::vector<Result> s_Results;
+        return s_Results;
+    }
+
+    /*!
+     * \brief
+     *      Benchmark currently running, set by the driver
+     * \return
+     *      Name of the running benchmark
+     */
+    inline std::string &CurrentGroup()
+    {
+        static std::string s_Group;
+        return s_Group;
+    }
+
+    /*!
+     * \brief
+     *      Stream the results table is printed to
+     * \return
+     *      Table stream, stdout by default
+     */
+    inline std::FILE *&Output()
+    {
+        static std::FILE *s_Output = stdout;
+        return s_Output;
+    }
+
+    /*!
+     * \brief
+     *      Heap allocation counters, maintained by the driver's global operator new
+     */
+    struct AllocationCount
+    {
+        size_t m_Count;    //!< Number of allocations
+        size_t m_Bytes;    //!< Bytes requested
+    };
+
+    AllocationCount Allocations();    //!< Allocations made by the process so far
+    long PeakRssKb();                 //!< Peak resident set size of the process in KiB (-1 if unavailable)
+
+    /*!
+     * \brief
+     *      Records and prints a measurement
+     * \param name
+     *      Name of the measurement
+     * \param value
+     *      Measured value
+     * \param unit
+     *      Unit of value
+     * \param allocs_per_op
+     *      Heap allocations per operation (Negative if not measured)
+     * \param bytes_per_op
+     *      Heap bytes per operation (Negative if not measured)
+     */
+    inline void Report(const std::string &name, double value, const std::string &unit,
+                       double allocs_per_op = -1, double bytes_per_op = -1)
+    {
+        if (allocs_per_op >= 0)
+            std::fprintf(Output(), "%-56s %14.1f %-6s %10.2f allocs/op %10.1f B/op\n", name.c_str(), value,
+                         unit.c_str(), allocs_per_op, bytes_per_op);
+        else
+            std::fprintf(Output(), "%-56s %14.1f %s\n", name.c_str(), value, unit.c_str());
+        Results().push_back({CurrentGroup(), name, value, unit, allocs_per_op, bytes_per_op});
+    }
+
+    /*!
+     * \brief
+     *      Registers a benchmark on construction
+     */
+    struct Registrar
+    {
+        Registrar(const char *name, BenchmarkFn fn)
+        { Registry().emplace_back(name, fn); }
+    };
+
+    /*!
+     * \brief
+     *      Prevents the compiler from optimizing away a value
+     * \param value
+     *      Value to keep
+     */
+    template<typename T>
+    inline void DoNotOptimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *s_Sink;
+        s_Sink = &value;
+#endif
+    }
+
+    /*!
+     * \brief
+     *      Generates reproducible lowercase identifiers
+     * \param count
+     *      Number of words
+     * \param seed
+     *      Random seed, the same seed always yields the same words
+     * \return
+     *      Words of 4 to 16 characters (May contain duplicates)
+     */
+    inline std::vector<std::string> RandomWords(size_t count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> length(4, 16);
+        std::uniform_int_distribution<int> letter('a', 'z');
+
+        std::vector<std::string> words(count);
+        for (auto &word : words)
+        {
+            word.resize(size_t(length(rng)));
+            for (auto &c : word)
+                c = char(letter(rng));
+        }
+        return words;
+    }
+
+    /*!
+     * \brief
+     *      Times a workload and reports its average cost and heap allocations
+     * \param name
+     *      Name of the measurement
+     * \param iterations
+     *      Times to run the workload
+     * \param fn
+     *      Workload, ran once per iteration
+     * \return
+     *      Nanoseconds per iteration
+     */
+    template<typename Fn>
+    double Measure(const std::string &name, size_t iterations, Fn &&fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        // Warm up.
+        for (size_t i = 0; i < iterations / 10 + 1; ++i)
+            fn();
+
+        AllocationCount before = Allocations();
+        auto begin = clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            fn();
+        auto end = clock::now();
+        AllocationCount after = Allocations();
+
+        double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / double(iterations);
+        Report(name, ns, "ns/op", double(after.m_Count - before.m_Count) / double(iterations),
+               double(after.m_Bytes - before.m_Bytes) / double(iterations));
+        return ns;
+    }
+}
+
+//!< Defines and registers a benchmark.
+#define CSYS_BENCHMARK(NAME) \
+    static void NAME(); \
+    static bench::Registrar NAME##_registrar(#NAME, NAME); \
+    static void NAME()
+
+#endif //CSYS_BENCH_H
@@ -0,0 +1,228 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/autocomplete.h"
+#include "csys/compact_autocomplete.h"
+#include <algorithm>
+#include <cstdio>
+
+CSYS_BENCHMARK(autocomplete)
+{
+    for (size_t count : {size_t(10000), size_t(50000), size_t(100000)})
+    {
+        auto words = bench::RandomWords(count, 91011);
+        std::string suffix = std::to_string(count);
+
+        // Build.
+        bench::Measure("autocomplete/build/" + suffix, 5, [&]()
+        {
+            csys::AutoComplete tree;
+            for (const auto &word : words)
+                tree.Insert(word);
+            bench::DoNotOptimize(tree.Size());
+        });
+
+        csys::AutoComplete tree;
+        for (const auto &word : words)
+            tree.Insert(word);
+
+        // Copy, as done when copying a System. Nodes are shared until the copy is modified.
+        bench::Measure("autocomplete/copy/" + suffix, 1000, [&]()
+        {
+            csys::AutoComplete copy(tree);
+            bench::DoNotOptimize(copy.Size());
+        });
+        bench::Measure("autocomplete/copy_insert/" + suffix, 20, [&]()
+        {
+            csys::AutoComplete copy(tree);
+            copy.Insert("copied");
+            bench::DoNotOptimize(copy.Size());
+        });
+
+        // Exact search.
+        size_t i = 0;
+        bench::Measure("autocomplete/search/" + suffix, 1000000, [&]()
+        {
+            bench::DoNotOptimize(tree.Search(words[i++ % count].c_str()));
+        });
+
+        // Prefix sweep, shorter prefixes match more words.
+        for (size_t length : {size_t(1), size_t(2), size_t(3), size_t(4)})
+        {
+            std::vector<std::string> prefixes;
+            for (size_t j = 0; j < 1024; ++j)
+                prefixes.emplace_back(words[(j * 7919) % count].substr(0, length));
+
+            csys::AutoComplete::sVector suggestions;
+            i = 0;
+            bench::Measure("autocomplete/suggestions/prefix_" + std::to_string(length) + "/" + suffix,
+                           length == 1 ? 200 : 20000, [&]()
+            {
+                suggestions.clear();
+                tree.Suggestions(prefixes[i++ & 1023].c_str(), suggestions);
+                bench::DoNotOptimize(suggestions.size());
+            });
+
+            // First 10 only, as shown by a UI.
+            i = 0;
+            bench::Measure("autocomplete/top10/prefix_" + std::to_string(length) + "/" + suffix, 200000, [&]()
+            {
+                size_t chars = 0;
+                tree.Suggestions(prefixes[i++ & 1023], 10, [&chars](std::string_view word) { chars += word.size(); });
+                bench::DoNotOptimize(chars);
+            });
+
+            // "N more" count.
+            i = 0;
+            bench::Measure("autocomplete/count/prefix_" + std::to_string(length) + "/" + suffix,
+                           length == 1 ? 200 : 20000, [&]()
+            {
+                bench::DoNotOptimize(tree.SuggestionCount(prefixes[i++ & 1023]));
+            });
+        }
+
+        // Typing a word, top 10 shown after every keystroke.
+        i = 0;
+        bench::Measure("autocomplete/keystrokes/scratch/" + suffix, 20000, [&]()
+        {
+            const std::string &word = words[(i++ * 7919) % count];
+            size_t chars = 0;
+            for (size_t length = 1; length <= word.size(); ++length)
+                tree.Suggestions(std::string_view(word).substr(0, length), 10,
+                                 [&chars](std::string_view suggestion) { chars += suggestion.size(); });
+            bench::DoNotOptimize(chars);
+        });
+
+        i = 0;
+        csys::AutoComplete::Cursor cursor(tree);
+        bench::Measure("autocomplete/keystrokes/cursor/" + suffix, 20000, [&]()
+        {
+            const std::string &word = words[(i++ * 7919) % count];
+            size_t chars = 0;
+            cursor.Clear();
+            for (char c : word)
+            {
+                cursor.Push(c);
+                cursor.Suggestions(10, [&chars](std::string_view suggestion) { chars += suggestion.size(); });
+            }
+            bench::DoNotOptimize(chars);
+        });
+
+        // Most used first, with a skewed use count per word.
+        csys::AutoComplete ranked(tree);
+        for (size_t j = 0; j < count; ++j)
+            ranked.Hit(words[j], uint32_t(count / (j + 1)));
+
+        i = 0;
+        bench::Measure("autocomplete/hit/" + suffix, 1000000, [&]()
+        {
+            bench::DoNotOptimize(ranked.Hit(words[i++ % count]));
+        });
+
+        for (size_t length : {size_t(1), size_t(2)})
+        {
+            std::vector<std::string> prefixes;
+            for (size_t j = 0; j < 1024; ++j)
+                prefixes.emplace_back(words[(j * 7919) % count].substr(0, length));
+
+            csys::AutoComplete::sVector suggestions;
+            i = 0;
+            bench::Measure("autocomplete/ranked_top10/prefix_" + std::to_string(length) + "/" + suffix, 20000, [&]()
+            {
+                suggestions.clear();
+                ranked.RankedSuggestions(prefixes[i++ & 1023], 10, suggestions);
+                bench::DoNotOptimize(suggestions.size());
+            });
+        }
+
+        // Typo tolerant search, a query per keystroke.
+        for (size_t distance : {size_t(1), size_t(2)})
+        {
+            std::vector<std::string> queries;
+            for (size_t j = 0; j < 1024; ++j)
+            {
+                std::string query = words[(j * 7919) % count];
+                std::swap(query[1], query[2]);
+                queries.push_back(query);
+            }
+
+            csys::AutoComplete::sVector suggestions;
+            i = 0;
+            bench::Measure("autocomplete/fuzzy/distance_" + std::to_string(distance) + "/" + suffix, 2000, [&]()
+            {
+                suggestions.clear();
+                tree.FuzzySuggestions(queries[i++ & 1023], distance, 10, suggestions);
+                bench::DoNotOptimize(suggestions.size());
+            });
+        }
+
+        // Compact index.
+        bench::Measure("autocomplete/compact/build/" + suffix, 5, [&]()
+        {
+            csys::CompactAutoComplete compact(tree);
+            bench::DoNotOptimize(compact.Size());
+        });
+
+        csys::CompactAutoComplete compact(tree);
+        bench::Report("autocomplete/compact/nodes/" + suffix, double(compact.Size()), "nodes");
+        bench::Report("autocomplete/tree/nodes/" + suffix, double(tree.Size()), "nodes");
+
+        std::string path = "csys_bench_compact_" + suffix + ".bin";
+        compact.Save(path);
+        bench::Measure("autocomplete/compact/map/" + suffix, 1000, [&]()
+        {
+            csys::CompactAutoComplete mapped;
+            bench::DoNotOptimize(mapped.Map(path));
+        });
+
+        csys::CompactAutoComplete mapped;
+        mapped.Map(path);
+        i = 0;
+        bench::Measure("autocomplete/compact/search/" + suffix, 1000000, [&]()
+        {
+            bench::DoNotOptimize(mapped.Search(words[i++ % count].c_str()));
+        });
+        std::remove(path.c_str());
+    }
+
+    // Names registered sorted, as a module listing its commands does, then rebalanced.
+    const char *subsystems[] = {"ai", "anim", "cl", "fx", "net", "phys", "r", "snd", "sv", "ui"};
+    auto words = bench::RandomWords(2000, 1213);
+    std::vector<std::string> names;
+    for (const char *subsystem : subsystems)
+        for (const auto &word : words)
+            names.push_back(std::string(subsystem) + "_" + word);
+    std::sort(names.begin(), names.end());
+    std::string suffix = std::to_string(names.size());
+
+    csys::AutoComplete sorted;
+    for (const auto &name : names)
+        sorted.Insert(name);
+    bench::Measure("autocomplete/rebalance/" + suffix, 20, [&]()
+    {
+        csys::AutoComplete copy(sorted);
+        copy.Rebalance();
+        bench::DoNotOptimize(copy.Size());
+    });
+    bench::Measure("autocomplete/bulk_build/" + suffix, 20, [&]()
+    {
+        csys::AutoComplete built(names);
+        bench::DoNotOptimize(built.Size());
+    });
+
+    csys::AutoComplete balanced(sorted);
+    balanced.Rebalance();
+    for (auto [tree, shape] : {std::make_pair(&sorted, "sorted"), std::make_pair(&balanced, "balanced")})
+    {
+        auto stats = tree->Statistics();
+        bench::Report(std::string("autocomplete/") + shape + "/max_depth/" + suffix, double(stats.m_MaxDepth), "nodes");
+        bench::Report(std::string("autocomplete/") + shape + "/average_depth/" + suffix, stats.m_AverageDepth, "nodes");
+
+        size_t i = 0;
+        bench::Measure(std::string("autocomplete/") + shape + "/search/" + suffix, 1000000, [&]()
+        {
+            bench::DoNotOptimize(tree->Search(names[(i++ * 7919) % names.size()].c_str()));
+        });
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/system.h"
+#include <random>
+
+namespace
+{
+    // Registers 'count' commands taking every argument type in Args, and a random sample of lines invoking them.
+    template<typename... Args>
+    void Populate(csys::System &system, size_t count, std::vector<std::string> &lines, const std::string &arguments,
+                  size_t &sink)
+    {
+        for (size_t i = 0; i < count; ++i)
+            system.RegisterCommand("command_" + std::to_string(i), "", [&sink](const Args &...) { ++sink; },
+                                   csys::Arg<Args>("arg")...);
+
+        std::mt19937 rng(4321);
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        lines.clear();
+        for (size_t i = 0; i < 1024; ++i)
+            lines.emplace_back("command_" + std::to_string(pick(rng)) + " " + arguments);
+    }
+
+    // Times RunCommand over N commands of one signature.
+    template<typename... Args>
+    void Run(const char *signature, const std::string &arguments)
+    {
+        for (size_t count : {size_t(100), size_t(10000)})
+        {
+            csys::System system;
+            std::vector<std::string> lines;
+            size_t sink = 0;
+            Populate<Args...>(system, count, lines, arguments, sink);
+
+            size_t i = 0;
+            bench::Measure(std::string("commands/") + signature + "/" + std::to_string(count), 500000, [&]()
+            {
+                if ((i & 1023) == 0) system.Items().clear();
+                system.RunCommand(lines[i++ & 1023]);
+            });
+            bench::DoNotOptimize(sink);
+        }
+    }
+
+    // Times calling one command directly, parsing 'arguments' or running them already compiled.
+    template<typename Fn, typename... Args>
+    void Call(const char *name, const std::string &arguments, Fn function, Args... args)
+    {
+        csys::Command<Fn, Args...> command(name, "", std::move(function), args...);
+        std::unique_ptr<csys::ArgumentPack> pack;
+        command.Compile(arguments, pack);
+
+        bench::Measure(std::string("commands/call/") + name, 2000000, [&]()
+        { bench::DoNotOptimize(command(arguments)); });
+        bench::Measure(std::string("commands/call/") + name + "/compiled", 2000000, [&]()
+        { bench::DoNotOptimize(command.Run(*pack)); });
+    }
+}
+
+CSYS_BENCHMARK(commands)
+{
+    // Call overhead.
+    size_t sink = 0;
+    Call("noop", "", [&sink]() { ++sink; });
+    Call("int", "42", [&sink](int a) { sink += size_t(a); }, csys::Arg<int>("a"));
+    Call("string", "\"some text\"", [&sink](const csys::String &str) { sink += str.m_String.size(); },
+         csys::Arg<csys::String>("str"));
+    std::string vector = "[";
+    for (int i = 0; i < 256; ++i)
+        vector += std::to_string(i) + " ";
+    Call("vector_256", vector + "]", [&sink](const std::vector<int> &values) { sink += values.size(); },
+         csys::Arg<std::vector<int>>("values"));
+    bench::DoNotOptimize(sink);
+
+    Run<int>("int", "42");
+    Run<int, int, int, int>("int_x4", "1 -2 3 -4");
+    Run<float, double>("float_double", "3.5 -2.25e3");
+    Run<csys::String, bool>("string_bool", "\"some text\" true");
+    Run<std::vector<int>>("vector_int", "[1 2 3 4 5 6 7 8]");
+    Run<int, float, csys::String, bool, char>("mixed_x5", "7 0.5 word false c");
+}
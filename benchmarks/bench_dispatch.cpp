@@ -0,0 +1,65 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/system.h"
+#include <random>
+
+namespace
+{
+    // Exposes command lookup.
+    struct DispatchProbe : csys::System
+    {
+        using System::ParseCommandKey;
+        using System::FindCommand;
+    };
+
+    // System with 'count' no-op commands and a random sample of lines invoking them.
+    void Populate(csys::System &system, size_t count, std::vector<std::string> &lines, size_t &sink)
+    {
+        for (size_t i = 0; i < count; ++i)
+            system.RegisterCommand("command_" + std::to_string(i), "", [&sink]() { ++sink; });
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        lines.clear();
+        for (size_t i = 0; i < 1024; ++i)
+            lines.emplace_back("command_" + std::to_string(pick(rng)));
+    }
+}
+
+CSYS_BENCHMARK(dispatch)
+{
+    for (size_t count : {size_t(100), size_t(10000), size_t(100000)})
+    {
+        DispatchProbe system;
+        std::vector<std::string> lines;
+        size_t sink = 0;
+        Populate(system, count, lines, sink);
+
+        for (bool frozen : {false, true})
+        {
+            if (frozen) system.Freeze();
+            std::string suffix = std::string(frozen ? "frozen/" : "unfrozen/") + std::to_string(count);
+
+            // Lookup only.
+            size_t i = 0;
+            bench::Measure("dispatch/lookup/" + suffix, 2000000, [&]()
+            {
+                size_t index = 0;
+                csys::CommandKeyView key{};
+                system.ParseCommandKey(lines[i++ & 1023], index, key);
+                bench::DoNotOptimize(system.FindCommand(key));
+            });
+
+            // Full RunCommand (Logging and history included).
+            i = 0;
+            bench::Measure("dispatch/run_command/" + suffix, 1000000, [&]()
+            {
+                if ((i & 1023) == 0) system.Items().clear();
+                system.RunCommand(lines[i++ & 1023]);
+            });
+        }
+        bench::DoNotOptimize(sink);
+    }
+}
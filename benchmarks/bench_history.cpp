@@ -0,0 +1,24 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/history.h"
+
+CSYS_BENCHMARK(history)
+{
+    auto lines = bench::RandomWords(1024, 1213);
+    for (auto &line : lines)
+        line = "command " + line + " 1 2 3";
+
+    for (unsigned capacity : {100u, 10000u})
+    {
+        csys::CommandHistory history(capacity);
+
+        size_t i = 0;
+        bench::Measure("history/push_back/" + std::to_string(capacity), 2000000, [&]()
+        {
+            history.PushBack(lines[i++ & 1023]);
+        });
+        bench::DoNotOptimize(history.Size());
+    }
+}
@@ -0,0 +1,195 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/command.h"
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Replica of the previous parsers: input was copied into a csys::String by the command, numbers went through
+    // std::sto* on a substring, and vectors blanked their brackets in place.
+    namespace legacy
+    {
+        template<typename T, typename Fn>
+        T Number(csys::String &input, size_t &start, Fn fn)
+        {
+            auto range = input.NextPoi(start);
+            return T(fn(input.m_String.substr(range.first, range.second - range.first), &range.first));
+        }
+
+        int Int(csys::String &input, size_t &start)
+        { return Number<int>(input, start, [](const std::string &s, size_t *i) { return std::stoi(s, i); }); }
+
+        float Float(csys::String &input, size_t &start)
+        { return Number<float>(input, start, [](const std::string &s, size_t *i) { return std::stof(s, i); }); }
+
+        double Double(csys::String &input, size_t &start)
+        { return Number<double>(input, start, [](const std::string &s, size_t *i) { return std::stod(s, i); }); }
+
+        bool Bool(csys::String &input, size_t &start)
+        {
+            auto range = input.NextPoi(start);
+            for (size_t i = range.first; i < range.second; ++i)
+                input.m_String[i] = char(std::tolower(input.m_String[i]));
+            return input.m_String.compare(range.first, range.second - range.first, "true") == 0;
+        }
+
+        // Whitespace scan through the C locale, one char at a time.
+        std::pair<size_t, size_t> NextPoi(std::string_view str, size_t &start)
+        {
+            size_t end = str.size();
+            std::pair<size_t, size_t> range(end + 1, end);
+            size_t pos = start;
+            for (; pos < end; ++pos)
+                if (!std::isspace(str[pos]) && str[pos] != '\0')
+                {
+                    range.first = pos;
+                    break;
+                }
+            for (; pos < end; ++pos)
+                if (std::isspace(str[pos]) || str[pos] == '\0')
+                {
+                    range.second = pos;
+                    break;
+                }
+            start = range.second;
+            return range;
+        }
+
+        std::vector<int> IntVector(csys::String &input, size_t &start)
+        {
+            std::vector<int> value;
+            auto range = input.NextPoi(start);
+            input.m_String[range.first] = ' ';
+            range.second = input.m_String.find(']', range.first);
+            input.m_String[range.second] = ' ';
+            start = range.first;
+            while (input.NextPoi(range.first).first < range.second)
+            {
+                value.push_back(Int(input, start));
+                range.first = start;
+            }
+            return value;
+        }
+    }
+
+    // Times the previous (copy + mutate) and current (view) path of one argument type.
+    template<typename T, typename Legacy>
+    void Compare(const char *type, const std::string &line, Legacy legacy_parse)
+    {
+        bench::Measure(std::string("parser/legacy/") + type, 1000000, [&]()
+        {
+            csys::String copy(line);
+            size_t start = 0;
+            bench::DoNotOptimize(legacy_parse(copy, start));
+        });
+
+        bench::Measure(std::string("parser/string_view/") + type, 1000000, [&]()
+        {
+            size_t start = 0;
+            bench::DoNotOptimize(csys::Arg<T>::ParseValue(line, start));
+        });
+    }
+
+    // Times splitting a long line into words with the C locale and with csys::Scan, in line bytes per second.
+    void Words(const char *name, const std::string &line)
+    {
+        auto Split = [&line](auto next_poi)
+        {
+            size_t start = 0, count = 0;
+            while (next_poi(line, start).first <= line.size())
+                ++count;
+            bench::DoNotOptimize(count);
+        };
+
+        std::string prefix = std::string("parser/words/") + name;
+        double legacy = bench::Measure(prefix + "/legacy", 2000, [&]() { Split(legacy::NextPoi); });
+        double scan = bench::Measure(prefix + "/scan", 2000, [&]()
+        {
+            Split([](std::string_view str, size_t &start) { return csys::String::NextPoi(str, start); });
+        });
+        bench::Report(prefix + "/legacy/throughput", double(line.size()) / legacy * 1e3, "MB/s");
+        bench::Report(prefix + "/scan/throughput", double(line.size()) / scan * 1e3, "MB/s");
+    }
+
+    // Times parsing a long vector argument, in line bytes per second.
+    template<typename T>
+    void LongVector(const char *name, const std::string &line)
+    {
+        std::string prefix = std::string("parser/long_vector/") + name;
+        double ns = bench::Measure(prefix, 2000, [&]()
+        {
+            size_t start = 0;
+            bench::DoNotOptimize(csys::Arg<T>::ParseValue(line, start));
+        });
+        bench::Report(prefix + "/throughput", double(line.size()) / ns * 1e3, "MB/s");
+    }
+
+    // Builds "[" + element(0) + separator + element(1) ... + "]".
+    template<typename Element>
+    std::string Vector(size_t count, const std::string &separator, Element element)
+    {
+        std::string line = "[";
+        for (size_t i = 0; i < count; ++i)
+            line += element(i) + separator;
+        return line + "]";
+    }
+
+    // Argument I of a command alternates between an int and a quoted string.
+    template<size_t I>
+    using Alternating = std::conditional_t<I % 2 == 0, csys::Arg<int>, csys::Arg<csys::String>>;
+
+    // Times a command taking N arguments, alternating ints and quoted strings. The line is split into tokens once,
+    // each argument then only converts its own token.
+    template<size_t... Is>
+    void Arguments(const std::index_sequence<Is...> &)
+    {
+        size_t sink = 0;
+        csys::Command command("command", "", [&sink](const typename Alternating<Is>::ValueType &...) { ++sink; },
+                              Alternating<Is>("arg")...);
+
+        std::string line;
+        for (size_t i = 0; i < sizeof...(Is); ++i)
+            line += i % 2 == 0 ? std::to_string(i * 1000) + " " : "\"text number " + std::to_string(i) + "\" ";
+
+        bench::Measure("parser/command/args_" + std::to_string(sizeof...(Is)), 200000, [&]()
+        {
+            bench::DoNotOptimize(command(line));
+        });
+        bench::Report("parser/command/args_" + std::to_string(sizeof...(Is)) + "/line", double(line.size()), "chars");
+        bench::DoNotOptimize(sink);
+    }
+}
+
+CSYS_BENCHMARK(parser)
+{
+    Compare<int>("int", "  -123456", legacy::Int);
+    Compare<float>("float", "  3.14159", legacy::Float);
+    Compare<double>("double", "  -2.718281828459045e10", legacy::Double);
+    Compare<bool>("bool", "  TRUE", legacy::Bool);
+    Compare<std::vector<int>>("vector<int>", "  [1 2 3 4 5 6 7 8]", legacy::IntVector);
+
+    Arguments(std::make_index_sequence<1>{});
+    Arguments(std::make_index_sequence<8>{});
+    Arguments(std::make_index_sequence<32>{});
+
+    // Long lines, short tokens and aligned columns.
+    std::string ints = Vector(4096, " ", [](size_t i) { return std::to_string(i); });
+    std::string columns = Vector(1024, std::string(24, ' '), [](size_t i) { return std::to_string(i); });
+    std::string words = Vector(1024, " ", [](size_t i) { return "identifier_" + std::to_string(i) + "_with_a_long_name"; });
+    std::string quoted = Vector(1024, " ", [](size_t i) { return "\"quoted text number " + std::to_string(i) + "\""; });
+
+    std::fprintf(bench::Output(), "Scanning with %s\n", csys::Scan::s_Backend);
+    Words("ints", ints);
+    Words("columns", columns);
+    Words("words", words);
+    LongVector<std::vector<int>>("ints", ints);
+    LongVector<std::vector<int>>("columns", columns);
+    LongVector<std::vector<csys::String>>("words", words);
+    LongVector<std::vector<csys::String>>("quoted", quoted);
+}
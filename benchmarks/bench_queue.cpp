@@ -0,0 +1,76 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/system.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+CSYS_BENCHMARK(queue)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr size_t per_producer = 200000;
+
+    for (size_t producers : {size_t(1), size_t(2), size_t(4), size_t(8)})
+    {
+        csys::System system;
+        size_t sink = 0;
+        system.RegisterCommand("noop", "", [&sink]() { ++sink; });
+        system.CreateQueue(4096, 64);
+
+        // Every producer times each of its Enqueue calls.
+        std::atomic<size_t> done(0);
+        std::atomic<bool> start(false);
+        std::vector<std::vector<uint32_t>> latencies(producers);
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&, p]()
+            {
+                auto &latency = latencies[p];
+                latency.reserve(per_producer * 2);
+                while (!start.load()) std::this_thread::yield();
+
+                for (size_t i = 0; i < per_producer; ++i)
+                {
+                    while (true)
+                    {
+                        auto begin = clock::now();
+                        bool queued = system.Enqueue("noop");
+                        auto end = clock::now();
+                        latency.push_back(uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+                        if (queued) break;
+                        std::this_thread::yield();
+                    }
+                }
+                ++done;
+            });
+        }
+
+        // Owning thread drains as a frame loop would.
+        auto begin = clock::now();
+        start = true;
+        size_t drained = 0;
+        while (done.load() < producers || drained < producers * per_producer)
+        {
+            drained += system.DrainQueue(1024);
+            system.Items().clear();
+        }
+        auto end = clock::now();
+        for (auto &thread : threads)
+            thread.join();
+
+        // Merge latencies.
+        std::vector<uint32_t> all;
+        for (auto &latency : latencies)
+            all.insert(all.end(), latency.begin(), latency.end());
+        std::nth_element(all.begin(), all.begin() + long(all.size() * 99 / 100), all.end());
+
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::string suffix = std::to_string(producers) + "_producers";
+        bench::Report("queue/throughput/" + suffix, double(drained) / seconds, "cmd/s");
+        bench::Report("queue/enqueue_p99/" + suffix, double(all[all.size() * 99 / 100]), "ns");
+        bench::DoNotOptimize(sink);
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/system.h"
+#include <cstdio>
+#include <fstream>
+
+CSYS_BENCHMARK(scripts)
+{
+    for (size_t lines : {size_t(1000), size_t(10000)})
+    {
+        // Script mixing commands and variable sets.
+        std::string path = "csys_bench_script_" + std::to_string(lines) + ".txt";
+        {
+            std::ofstream file(path);
+            for (size_t i = 0; i < lines; ++i)
+            {
+                if (i % 2)
+                    file << "add " << i << ' ' << i * 3 << '\n';
+                else
+                    file << "set value " << i << '\n';
+            }
+        }
+
+        std::string suffix = std::to_string(lines) + "_lines";
+
+        // Reading from disk.
+        csys::Script script(path, false);
+        bench::Measure("scripts/load/" + suffix, 200, [&]()
+        {
+            script.Reload();
+            bench::DoNotOptimize(script.Data().size());
+        });
+
+        // Running an already loaded script.
+        csys::System system;
+        int sum = 0, value = 0;
+        system.RegisterCommand("add", "", [&sum](int a, int b) { sum += a + b; }, csys::Arg<int>("a"), csys::Arg<int>("b"));
+        system.RegisterVariable("value", value, csys::Arg<int>("value"));
+        system.RegisterScript("script", path);
+        bench::Measure("scripts/run/" + suffix, 50, [&]()
+        {
+            system.RunScript("script");
+            system.Items().clear();
+        });
+        bench::DoNotOptimize(sum);
+
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/system.h"
+#include "csys/substring_index.h"
+
+namespace
+{
+    // Names following the subsystem_feature_param convention, and a feature token to search for each.
+    void Populate(csys::System &system, size_t count, std::vector<std::string> &names, std::vector<std::string> &queries)
+    {
+        const char *subsystems[] = {"r", "cl", "sv", "snd", "net", "ui", "phys", "ai", "anim", "fx"};
+        auto features = bench::RandomWords(200, 777);
+        auto params = bench::RandomWords(500, 888);
+
+        names.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            names.push_back(std::string(subsystems[i % 10]) + "_" + features[(i / 10) % 200].substr(0, 6) + "_" +
+                            params[i % 500].substr(0, 5) + std::to_string(i));
+            system.RegisterCommand(names.back(), "", []() {});
+        }
+
+        queries.clear();
+        for (size_t i = 0; i < 1024; ++i)
+            queries.push_back(features[(i * 37) % 200].substr(0, 6));
+    }
+}
+
+CSYS_BENCHMARK(search)
+{
+    for (size_t count : {size_t(1000), size_t(10000), size_t(100000)})
+    {
+        csys::System system;
+        std::vector<std::string> names, queries;
+        Populate(system, count, names, queries);
+        std::string suffix = std::to_string(count);
+
+        // Index upkeep, as paid on registration.
+        bench::Measure("search/index_build/" + suffix, 5, [&]()
+        {
+            csys::SubstringIndex index;
+            for (const auto &name : names)
+                index.Insert(name);
+            bench::DoNotOptimize(index.Count());
+        });
+
+        // Middle token, top 10.
+        size_t i = 0;
+        bench::Measure("search/index/" + suffix, 20000, [&]()
+        {
+            bench::DoNotOptimize(system.Search(queries[i++ & 1023], 10).size());
+        });
+
+        // Every registered command checked.
+        i = 0;
+        bench::Measure("search/linear_scan/" + suffix, count >= 100000 ? 50 : 500, [&]()
+        {
+            const std::string &query = queries[i++ & 1023];
+            std::vector<std::string> matches;
+            for (const auto &command : system.Commands())
+                if (command.first.m_Verb == csys::CommandVerb::NONE && command.first.m_Name.find(query) != std::string::npos)
+                    matches.push_back(command.first.m_Name);
+            bench::DoNotOptimize(matches.size());
+        });
+
+        // Line completion, one keystroke of a command name, then of a command name after help.
+        i = 0;
+        bench::Measure("search/complete_line/command/" + suffix, 20000, [&]()
+        {
+            const std::string &name = names[(i++ * 7919) % count];
+            bench::DoNotOptimize(system.Complete(name, 2 + i % 6).m_Options.size());
+        });
+
+        std::vector<std::string> help_lines;
+        for (size_t j = 0; j < 1024; ++j)
+            help_lines.push_back("help " + names[(j * 7919) % count]);
+        i = 0;
+        bench::Measure("search/complete_line/help/" + suffix, 20000, [&]()
+        {
+            bench::DoNotOptimize(system.Complete(help_lines[i & 1023], 7 + i % 6).m_Options.size());
+            ++i;
+        });
+    }
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/system.h"
+#include <deque>
+#include <random>
+
+CSYS_BENCHMARK(variables)
+{
+    for (size_t count : {size_t(100), size_t(10000)})
+    {
+        // Storage must stay at the same address while registered.
+        csys::System system;
+        std::deque<int> ints(count);
+        std::deque<float> floats(count);
+        std::deque<bool> bools(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            system.RegisterVariable("int_" + std::to_string(i), ints[i], csys::Arg<int>("value"));
+            system.RegisterVariable("float_" + std::to_string(i), floats[i], csys::Arg<float>("value"));
+            system.RegisterVariable("bool_" + std::to_string(i), bools[i], csys::Arg<bool>("value"));
+        }
+
+        // Random mix of sets and gets over every variable.
+        std::mt19937 rng(5678);
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        std::vector<std::string> sets, gets;
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            std::string index = std::to_string(pick(rng));
+            switch (i % 3)
+            {
+                case 0: sets.emplace_back("set int_" + index + " " + std::to_string(i)); break;
+                case 1: sets.emplace_back("set float_" + index + " " + std::to_string(i) + ".5"); break;
+                default: sets.emplace_back("set bool_" + index + (i & 1 ? " true" : " false")); break;
+            }
+            gets.emplace_back("get " + sets.back().substr(4, sets.back().find(' ', 4) - 4));
+        }
+
+        std::string suffix = std::to_string(count * 3);
+        size_t i = 0;
+        bench::Measure("variables/set_storm/" + suffix, 500000, [&]()
+        {
+            if ((i & 1023) == 0) system.Items().clear();
+            system.RunCommand(sets[i++ & 1023]);
+        });
+
+        i = 0;
+        bench::Measure("variables/get_storm/" + suffix, 500000, [&]()
+        {
+            if ((i & 1023) == 0) system.Items().clear();
+            system.RunCommand(gets[i++ & 1023]);
+        });
+    }
+}
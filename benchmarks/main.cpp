@@ -0,0 +1,158 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#include "bench.h"
+#include "csys/exceptions.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+#ifdef _WIN32
+#  define NOMINMAX
+#  include <windows.h>
+#  include <psapi.h>
+#else
+#  include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::atomic<size_t> s_AllocationCount(0);    //!< Allocations made through operator new
+    std::atomic<size_t> s_AllocationBytes(0);    //!< Bytes requested through operator new
+
+    // Counts and forwards an allocation to malloc.
+    void *Allocate(size_t size)
+    {
+        s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+        s_AllocationBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void *ptr = std::malloc(size ? size : 1))
+            return ptr;
+        CSYS_THROW(std::bad_alloc());
+    }
+
+    // Escapes a string for a JSON document.
+    std::string Escape(const std::string &str)
+    {
+        std::string escaped;
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    // Writes every result and the process' peak RSS as JSON.
+    void WriteJson(std::ostream &os)
+    {
+        os.precision(10);
+        os << "{\n  \"peak_rss_kb\": " << bench::PeakRssKb() << ",\n  \"results\": [";
+        const auto &results = bench::Results();
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto &result = results[i];
+            os << (i ? ",\n" : "\n") << "    {\"group\": \"" << Escape(result.m_Group)
+               << "\", \"name\": \"" << Escape(result.m_Name)
+               << "\", \"value\": " << result.m_Value
+               << ", \"unit\": \"" << Escape(result.m_Unit) << '"';
+            if (result.m_AllocsPerOp >= 0)
+                os << ", \"allocs_per_op\": " << result.m_AllocsPerOp << ", \"bytes_per_op\": " << result.m_BytesPerOp;
+            os << '}';
+        }
+        os << "\n  ]\n}\n";
+    }
+}
+
+void *operator new(size_t size)
+{ return Allocate(size); }
+
+void *operator new[](size_t size)
+{ return Allocate(size); }
+
+void operator delete(void *ptr) noexcept
+{ std::free(ptr); }
+
+void operator delete[](void *ptr) noexcept
+{ std::free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept
+{ std::free(ptr); }
+
+void operator delete[](void *ptr, size_t) noexcept
+{ std::free(ptr); }
+
+namespace bench
+{
+    AllocationCount Allocations()
+    {
+        return {s_AllocationCount.load(std::memory_order_relaxed), s_AllocationBytes.load(std::memory_order_relaxed)};
+    }
+
+    long PeakRssKb()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return long(counters.PeakWorkingSetSize / 1024);
+        return -1;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return -1;
+#  ifdef __APPLE__
+        return long(usage.ru_maxrss / 1024);    // Bytes on macOS.
+#  else
+        return long(usage.ru_maxrss);
+#  endif
+#endif
+    }
+}
+
+// Usage: csys_bench [--json <file>] [filter]
+// Runs every benchmark whose name contains 'filter'. With --json, results are also written to 'file' ("-" for stdout,
+// in which case the table goes to stderr). Run one benchmark per process for a meaningful peak RSS.
+int main(int argc, char **argv)
+{
+    const char *filter = "";
+    const char *json = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json = argv[++i];
+        else
+            filter = argv[i];
+    }
+
+    // Keep stdout clean for the document.
+    bool json_stdout = json && std::strcmp(json, "-") == 0;
+    if (json_stdout)
+        bench::Output() = stderr;
+
+    for (const auto &benchmark : bench::Registry())
+    {
+        if (std::strstr(benchmark.first, filter) == nullptr)
+            continue;
+
+        std::fprintf(bench::Output(), "[%s]\n", benchmark.first);
+        bench::CurrentGroup() = benchmark.first;
+        benchmark.second();
+    }
+
+    if (json_stdout)
+        WriteJson(std::cout);
+    else if (json)
+    {
+        std::ofstream file(json);
+        if (!file)
+        {
+            std::fprintf(stderr, "Failed to open '%s'\n", json);
+            return 1;
+        }
+        WriteJson(file);
+    }
+
+    return 0;
+}
@@ -7,10 +7,21 @@
 
 #include "csys/api.h"
 #include "csys/string.h"
+#include "csys/scan.h"
 #include "csys/exceptions.h"
-#include <vector>
-#include <stdexcept>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cerrno>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace csys
 {
@@ -61,9 +72,9 @@ namespace csys
          * \return
          *      Returns true if the current char is the escaping char and is escaping
          */
-        static inline bool IsEscaping(std::string &input, size_t pos)
+        static inline bool IsEscaping(std::string_view input, size_t pos)
         {
-            return pos < input.size() - 1 && IsEscapeChar(input[pos]) && IsReservedChar(input[pos + 1]);
+            return pos + 1 < input.size() && IsEscapeChar(input[pos]) && IsReservedChar(input[pos + 1]);
         }
 
         /*!
@@ -75,8 +86,11 @@ namespace csys
          *      The current char to check if its being escaped
          * \return
          *      Returns true if the current char at 'pos' is being escaped
+         * \note
+         *      Walks backwards over every escape before 'pos'. Parsers scan forward with IsEscaping instead, calling this
+         *      on every char of a line is quadratic
          */
-        static inline bool IsEscaped(std::string &input, size_t pos)
+        static inline bool IsEscaped(std::string_view input, size_t pos)
         {
             bool result = false;
 
@@ -99,26 +113,421 @@ namespace csys
         Reserved& operator=(const Reserved&) = delete;
     };
 
+    /*!
+     * \brief
+     *      Finds the next argument of a command line in a single forward pass, resolving its structure:
+     *      - A quoted string runs to a closing '"' followed by whitespace, quotes joined by '"' or text are one argument
+     *      - A vector runs to the ']' matching its '[', a '[' only opens a nested vector at the start of an element
+     *      - Anything else runs to the next whitespace
+     *      Chars escaped with '\' never close a quote or a bracket. An unclosed quote or bracket runs to the end of input.
+     *      Every char is visited once, so the scan is linear in the length of the argument whatever the input
+     * \param input
+     *      Command line set of arguments
+     * \param start
+     *      Where to start scanning from. Will be set to pair.second
+     * \param in_vector
+     *      True if the argument is an element of a vector, a non-escaped ']' then also ends quoted strings and words
+     * \return
+     *      Returns the first char and one passed the end of the argument. In other words [first, second).
+     *      If only whitespace is left, first will be the size of input + 1 (Same as String::NextPoi)
+     */
+    inline std::pair<size_t, size_t> NextToken(std::string_view input, size_t &start, bool in_vector = false)
+    {
+        size_t end = input.size();
+
+        // Go to the first non-whitespace char
+        size_t pos = Scan::SkipSpace(input, start);
+        if (pos == end)
+        {
+            start = end;
+            return {end + 1, end};
+        }
+
+        std::pair<size_t, size_t> token(pos, end);
+
+        // Quoted string
+        if (input[pos] == '"')
+        {
+            // Only quotes, escapes and the end of a vector matter
+            auto Next = [&input, in_vector](size_t from)
+            {
+                return in_vector ? Scan::FindAny<'"', '\\', ']'>(input, from) : Scan::FindAny<'"', '\\'>(input, from);
+            };
+
+            for (pos = Next(pos + 1); pos < end; pos = Next(pos + 1))
+                if (Reserved::IsEscaping(input, pos))
+                    ++pos;
+                else if (input[pos] == '"')
+                {
+                    // Closed, unless joined to more text
+                    if (pos + 1 == end || Scan::IsSpace(input[pos + 1]) || (in_vector && input[pos + 1] == ']'))
+                    {
+                        token.second = pos + 1;
+                        break;
+                    }
+                    if (input[pos + 1] == '"')
+                        ++pos;
+                }
+                // End of the vector, the quote was never closed
+                else if (in_vector && input[pos] == ']')
+                {
+                    token.second = pos;
+                    break;
+                }
+        }
+        // Vector
+        else if (input[pos] == '[')
+        {
+            size_t depth = 0;
+            bool element = true;    // At the start of an element
+            while (pos < end)
+            {
+                // Skip chars that are neither whitespace, brackets nor escapes
+                size_t next = Scan::FindSpaceOr<'[', ']', '\\'>(input, pos);
+                if (next != pos)
+                {
+                    element = false;
+                    if ((pos = next) == end)
+                        break;
+                }
+
+                if (Reserved::IsEscaping(input, pos))
+                {
+                    pos += 2;
+                    element = false;
+                    continue;
+                }
+
+                // Whitespace starts an element
+                char c = input[pos];
+                if (Scan::IsSpace(c))
+                {
+                    pos = Scan::SkipSpace(input, pos);
+                    element = true;
+                    continue;
+                }
+
+                bool open = c == '[' && element;
+                if (open)
+                    ++depth;
+                else if (c == ']' && --depth == 0)
+                {
+                    token.second = pos + 1;
+                    break;
+                }
+                element = open || c == ']';
+                ++pos;
+            }
+        }
+        // Single word
+        else
+        {
+            if (!in_vector)
+                pos = Scan::FindSpace(input, pos);
+            // Escaped ] doesn't end the element
+            else
+                for (pos = Scan::FindSpaceOr<']', '\\'>(input, pos); pos < end && input[pos] == '\\';)
+                    pos = Scan::FindSpaceOr<']', '\\'>(input, pos + (Reserved::IsEscaping(input, pos) ? 2 : 1));
+            token.second = pos;
+        }
+
+        start = token.second;
+        return token;
+    }
+
+    /*!
+     * \brief
+     *      Arguments of a command line split by NextToken. Tokens are found in batches held in a small fixed array, a
+     *      command line is only scanned once no matter how many arguments it holds
+     */
+    class CSYS_API ArgumentTokens
+    {
+    public:
+
+        static constexpr size_t s_Capacity = 32;    //!< Tokens found per batch
+
+        /*!
+         * \brief
+         *      Splits the first batch of arguments
+         * \param input
+         *      Command line set of arguments, must outlive this
+         */
+        explicit ArgumentTokens(std::string_view input) : m_Input(input)
+        {
+            Fill();
+        }
+
+        /*!
+         * \brief
+         *      Gets the next argument
+         * \param[out] token
+         *      Range of the argument within the input, [first, second)
+         * \return
+         *      Returns false if no arguments are left
+         */
+        bool Next(std::pair<size_t, size_t> &token)
+        {
+            // Batch used up, find the next one
+            if (m_Index == m_Count && (m_Count < s_Capacity || !Fill()))
+                return false;
+
+            token = {m_First[m_Index], m_Last[m_Index]};
+            ++m_Index;
+            return true;
+        }
+
+    private:
+
+        /*!
+         * \brief
+         *      Finds the next batch of arguments
+         * \return
+         *      Returns false if none were left
+         */
+        bool Fill()
+        {
+            m_Index = m_Count = 0;
+            for (; m_Count < s_Capacity; ++m_Count)
+            {
+                auto token = NextToken(m_Input, m_Start);
+                if (token.first > m_Input.size())
+                    break;
+                m_First[m_Count] = token.first;
+                m_Last[m_Count] = token.second;
+            }
+            return m_Count != 0;
+        }
+
+        std::string_view m_Input;                   //!< Command line being split
+        size_t m_Start = 0;                         //!< Where the next batch starts
+        size_t m_Index = 0;                         //!< Next token of the batch
+        size_t m_Count = 0;                         //!< Tokens in the batch
+        std::array<size_t, s_Capacity> m_First;     //!< Start of the batch's tokens, left uninitialized passed m_Count
+        std::array<size_t, s_Capacity> m_Last;      //!< One passed the end of the batch's tokens
+    };
+
+    /*!
+     * \brief
+     *      Reasons parsing an argument can fail
+     */
+    enum class ParseErrorCode : unsigned char
+    {
+        NONE = 0,
+        NOT_ENOUGH_ARGUMENTS,
+        TOO_MANY_ARGUMENTS,
+        INVALID_NUMBER,
+        NUMBER_TOO_LARGE,
+        INVALID_BOOLEAN,
+        EXPECTED_TRUE,
+        EXPECTED_FALSE,
+        CHAR_COUNT,
+        TOO_MANY_CHARS,
+        RESERVED_CHAR,
+        MISSING_STRING,
+        MISSING_CLOSING_QUOTE,
+        MISSING_OPENING_BRACKET,
+        MISSING_CLOSING_BRACKET
+    };
+
+    /*!
+     * \brief
+     *      Result of parsing an argument. Only records what went wrong and where, the message is built on demand
+     */
+    struct CSYS_API ParseError
+    {
+        ParseErrorCode m_Code = ParseErrorCode::NONE;    //!< What went wrong
+        size_t m_First = 0;                              //!< Start of the offending text in the parsed input
+        size_t m_Last = 0;                               //!< One passed the end of the offending text
+        const char *m_TypeName = nullptr;                //!< Expected type, for number errors
+
+        /*!
+         * \brief
+         *      Checks if parsing failed
+         * \return
+         *      True if there is an error
+         */
+        explicit operator bool() const
+        { return m_Code != ParseErrorCode::NONE; }
+
+        /*!
+         * \brief
+         *      Builds the error message
+         * \param input
+         *      Input that was being parsed
+         * \return
+         *      Message in the form of "what went wrong: 'offending text'"
+         */
+        [[nodiscard]] std::string Message(std::string_view input) const
+        {
+            std::string message;
+            switch (m_Code)
+            {
+                case ParseErrorCode::NONE: return message;
+                case ParseErrorCode::NOT_ENOUGH_ARGUMENTS: message = "Not enough arguments were given"; break;
+                case ParseErrorCode::TOO_MANY_ARGUMENTS: message = "Too many arguments were given"; break;
+                case ParseErrorCode::INVALID_NUMBER: message = std::string("Missing or invalid ") + m_TypeName + " argument"; break;
+                case ParseErrorCode::NUMBER_TOO_LARGE: message = std::string("Argument too large for ") + m_TypeName; break;
+                case ParseErrorCode::INVALID_BOOLEAN: message = "Missing or invalid boolean argument"; break;
+                case ParseErrorCode::EXPECTED_TRUE: message = "Missing or invalid boolean argument, expected true"; break;
+                case ParseErrorCode::EXPECTED_FALSE: message = "Missing or invalid boolean argument, expected false"; break;
+                case ParseErrorCode::CHAR_COUNT: message = "Too many or no chars were given"; break;
+                case ParseErrorCode::TOO_MANY_CHARS: message = "Too many chars were given"; break;
+                case ParseErrorCode::RESERVED_CHAR: message = s_ErrMsgReserved; break;
+                case ParseErrorCode::MISSING_STRING: message = "Missing string argument"; break;
+                case ParseErrorCode::MISSING_CLOSING_QUOTE: message = "Could not find closing '\"'"; break;
+                case ParseErrorCode::MISSING_OPENING_BRACKET: message = "Invalid vector argument missing opening ["; break;
+                case ParseErrorCode::MISSING_CLOSING_BRACKET: message = "Invalid vector argument missing closing ]"; break;
+            }
+
+            size_t first = std::min(m_First, input.size());
+            return message + ": '" + std::string(input.substr(first, std::min(m_Last, input.size()) - first)) + "'";
+        }
+    };
+
+    /*!
+     * \brief
+     *      Makes an error over the offending text of a range
+     * \param code
+     *      What went wrong
+     * \param range
+     *      Offending text, [first, second)
+     * \param type_name
+     *      Expected type, for number errors
+     * \return
+     *      Parse error
+     */
+    inline ParseError MakeParseError(ParseErrorCode code, const std::pair<size_t, size_t> &range, const char *type_name = nullptr)
+    {
+        return ParseError{code, range.first, std::max(range.first, range.second), type_name};
+    }
+
+    /*!
+     * \brief
+     *      Gets the text of a range returned by String::NextPoi or NextToken
+     * \param input
+     *      Command line set of arguments
+     * \param range
+     *      Range within 'input'
+     * \return
+     *      View of the range, empty if only whitespace was left
+     */
+    inline std::string_view ArgumentToken(std::string_view input, const std::pair<size_t, size_t> &range)
+    {
+        return range.first < input.size() ? input.substr(range.first, range.second - range.first) : std::string_view();
+    }
+
+    /*!
+     * \brief
+     *      Reads a number with std::from_chars
+     * \tparam T
+     *      Integer or floating point type
+     * \param first
+     *      Start of the number
+     * \param last
+     *      One passed the end of the number
+     * \param value
+     *      Parsed value
+     * \return
+     *      Same as std::from_chars
+     */
+    template<typename T>
+    inline std::from_chars_result FromChars(const char *first, const char *last, T &value)
+    {
+#if !defined(__cpp_lib_to_chars)
+        // Standard library lacks floating point std::from_chars, read a null terminated copy instead
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            std::string copy(first, last);
+            char *end = nullptr;
+            errno = 0;
+            long double result = std::strtold(copy.c_str(), &end);
+            if (end == copy.c_str())
+                return {first, std::errc::invalid_argument};
+            if (errno == ERANGE || result > std::numeric_limits<T>::max() || result < std::numeric_limits<T>::lowest())
+                return {first + (end - copy.c_str()), std::errc::result_out_of_range};
+            value = static_cast<T>(result);
+            return {first + (end - copy.c_str()), std::errc()};
+        }
+        else
+#endif
+        return std::from_chars(first, last, value);
+    }
+
+    /*!
+     * \brief
+     *      Parses a number argument
+     * \tparam T
+     *      Integer or floating point type
+     * \param input
+     *      Command line set of arguments
+     * \param range
+     *      Argument within 'input', as returned by NextToken
+     * \param type_name
+     *      Name of the type for error messages
+     * \param value
+     *      Parsed value
+     * \return
+     *      Parse error, empty on success
+     */
+    template<typename T>
+    inline ParseError ParseNumber(std::string_view input, const std::pair<size_t, size_t> &range, const char *type_name, T &value)
+    {
+        std::string_view token = ArgumentToken(input, range);
+
+        // Skip explicit positive sign, std::from_chars does not take it
+        const char *first = token.data();
+        const char *last = token.data() + token.size();
+        if (token.size() > 1 && token[0] == '+' && token[1] != '+' && token[1] != '-')
+            ++first;
+
+        auto result = FromChars(first, last, value);
+        if (result.ec == std::errc::result_out_of_range)
+            return MakeParseError(ParseErrorCode::NUMBER_TOO_LARGE, range, type_name);
+        if (result.ec != std::errc() || result.ptr != last)
+            return MakeParseError(ParseErrorCode::INVALID_NUMBER, range, type_name);
+        return ParseError();
+    }
+
     /*!
      * \brief
      *      Used for parsing arguments of different types
      * \tparam T
      *      Argument type
+     *
+     * \note
+     *      Parsers never write to their input, so the same command line can be parsed several times or by several
+     *      threads at once. Failures are returned, never thrown
      */
     template<typename T>
     struct CSYS_API ArgumentParser
     {
         /*!
          * \brief
-         *      Constructor that parses the argument and sets value T
+         *      Parses the argument
          * \param input
          *      Command line set of arguments to be parsed
          * \param start
          *      Start in 'input' to where this argument should be parsed from
+         * \param value
+         *      Parsed value
+         * \return
+         *      Parse error, empty on success
          */
-        inline ArgumentParser(String &input, size_t &start);
+        static inline ParseError Parse(std::string_view input, size_t &start, T &value);
 
-        T m_Value; //!< Value of parsed argument
+        /*!
+         * \brief
+         *      Parses an argument already split from the command line
+         * \param input
+         *      Command line set of arguments to be parsed
+         * \param token
+         *      Argument within 'input', as returned by NextToken
+         * \param value
+         *      Parsed value
+         * \return
+         *      Parse error, empty on success
+         */
+        static inline ParseError ParseToken(std::string_view input, const std::pair<size_t, size_t> &token, T &value);
     };
 
     /*!
@@ -129,38 +538,20 @@ namespace csys
   template<> \
   struct CSYS_API ArgumentParser<TYPE> \
   { \
-    inline ArgumentParser(String &input, size_t &start); \
-    TYPE m_Value = 0; \
+    static inline ParseError Parse(std::string_view input, size_t &start, TYPE &value) \
+    { return ParseToken(input, NextToken(input, start), value); } \
+    static inline ParseError ParseToken(std::string_view input, const std::pair<size_t, size_t> &token, TYPE &value); \
   }; \
-  inline ArgumentParser<TYPE>::ArgumentParser(String &input, size_t &start)
-
-    /*!
-     * \brief
-     *      Macro for getting the sub-string within a range, used for readability
-     */
-#define ARG_PARSE_SUBSTR(range) input.m_String.substr(range.first, range.second - range.first)
+  inline ParseError ArgumentParser<TYPE>::ParseToken(std::string_view input, const std::pair<size_t, size_t> &range, TYPE &value)
 
     /*!
      * \brief
-     *      Macro for build-int types that already have functions in the stl for parsing them from a string
+     *      Macro for build-int types that can be parsed with std::from_chars
      */
-#define ARG_PARSE_GENERAL_SPEC(TYPE, TYPE_NAME, FUNCTION) \
+#define ARG_PARSE_GENERAL_SPEC(TYPE, TYPE_NAME) \
   ARG_PARSE_BASE_SPEC(TYPE) \
   { \
-    auto range = input.NextPoi(start); \
-    try \
-    { \
-      m_Value = (TYPE)FUNCTION(ARG_PARSE_SUBSTR(range), &range.first); \
-    } \
-    catch (const std::out_of_range&) \
-    { \
-      throw Exception(std::string("Argument too large for ") + TYPE_NAME, \
-                              input.m_String.substr(range.first, range.second));  \
-    } \
-    catch (const std::invalid_argument&) \
-    { \
-      throw Exception(std::string("Missing or invalid ") + TYPE_NAME + " argument", \
-                              input.m_String.substr(range.first, range.second)); } \
+    return ParseNumber<TYPE>(input, range, TYPE_NAME, value); \
   }
 
     /*!
@@ -169,81 +560,61 @@ namespace csys
      */
     ARG_PARSE_BASE_SPEC(csys::String)
     {
-        m_Value.m_String.clear(); // Empty string before using
+        value.m_String.clear(); // Empty string before using
 
-        // Lambda for getting a word from the string and checking for reserved chars
-        static auto GetWord = [](std::string &str, size_t start, size_t end)
+        // Lambda for appending a word from the string and checking for reserved chars
+        auto AppendWord = [&value](std::string_view str, size_t start, size_t end)
         {
-            // For issues with reserved chars
-            static std::string invalid_chars;
-            invalid_chars.clear();
-
-            std::string result;
-
             // Go through the str from start to end
             for (size_t i = start; i < end; ++i)
                 // general case, not reserved char
                 if (!Reserved::IsReservedChar(str[i]))
-                    result.push_back(str[i]);
+                    value.m_String.push_back(str[i]);
                 // is a reserved char
                 else
                 {
                     // check for \ char and if its escaping
                     if (Reserved::IsEscapeChar(str[i]) && Reserved::IsEscaping(str, i))
-                        result.push_back(str[++i]);
+                        value.m_String.push_back(str[++i]);
                     // reserved char but not being escaped
                     else
-                        throw Exception(s_ErrMsgReserved, str.substr(start, end - start));
+                        return MakeParseError(ParseErrorCode::RESERVED_CHAR, {start, end});
                 }
 
-            return result;
+            return ParseError();
         };
 
-        // Go to the start of the string argument
-        auto range = input.NextPoi(start);
+        // Only whitespace left
+        if (range.first >= input.size())
+            return MakeParseError(ParseErrorCode::MISSING_STRING, range);
 
         // If its a single string
-        if (input.m_String[range.first] != '"')
-            m_Value = GetWord(input.m_String, range.first, range.second);
-        // Multi word string
-        else
+        if (input[range.first] != '"')
+            return AppendWord(input, range.first, range.second);
+
+        // Multi word string, NextToken already found where it ends so it's read in one pass
+        for (size_t pos = range.first + 1; pos < range.second; ++pos)
         {
-            ++range.first; // move past the first "
-            while (true)
+            // Escaped reserved char
+            if (Reserved::IsEscaping(input, pos))
+                value.m_String.push_back(input[++pos]);
+            // Closing ", ends the argument or joins the next word
+            else if (input[pos] == '"')
             {
-                // Get the next non-escaped "
-                range.second = input.m_String.find('"', range.first);
-                while (range.second != std::string::npos && Reserved::IsEscaped(input.m_String, range.second))
-                    range.second = input.m_String.find('"', range.second + 1);
-
-                // Check for closing "
-                if (range.second == std::string::npos)
-                {
-                    range.second = input.m_String.size();
-                    throw Exception("Could not find closing '\"'", ARG_PARSE_SUBSTR(range));
-                }
-
-                // Add word to already existing string
-                m_Value.m_String += GetWord(input.m_String, range.first, range.second);
-
-                // Go to next word
-                range.first = range.second + 1;
-
-                // End of string check
-                if (range.first < input.m_String.size() && !std::isspace(input.m_String[range.first]) && input.m_String[range.first] != '\0')
-                {
-                    // joining two strings together
-                    if (input.m_String[range.first] == '"')
-                        ++range.first;
-                }
-                else
-                    // End of input
-                    break;
+                if (pos + 1 == range.second)
+                    return ParseError();
+                if (input[pos + 1] == '"')
+                    ++pos;
             }
+            // Reserved char but not being escaped
+            else if (Reserved::IsReservedChar(input[pos]))
+                return MakeParseError(ParseErrorCode::RESERVED_CHAR, range);
+            else
+                value.m_String.push_back(input[pos]);
         }
 
-        // Finished parsing
-        start = range.second + 1;
+        // Ran out of input before the closing "
+        return MakeParseError(ParseErrorCode::MISSING_CLOSING_QUOTE, {range.first, input.size()});
     }
 
     /*!
@@ -252,38 +623,38 @@ namespace csys
      */
     ARG_PARSE_BASE_SPEC(bool)
     {
-        // Error messages
-        static const char *s_err_msg = "Missing or invalid boolean argument";
-        static const char *s_false = "false";
-        static const char *s_true = "true";
+        // Case insensitive comparison against a lower case word
+        auto Matches = [](std::string_view token, std::string_view word)
+        {
+            for (size_t i = 0; i < token.size(); ++i)
+                if (std::tolower(static_cast<unsigned char>(token[i])) != word[i])
+                    return false;
+            return true;
+        };
 
         // Get argument
-        auto range = input.NextPoi(start);
-
-        // check if the length is between the len of "true" and "false"
-        input.m_String[range.first] = char(std::tolower(input.m_String[range.first]));
+        std::string_view token = ArgumentToken(input, range);
+        char first = token.empty() ? '\0' : char(std::tolower(static_cast<unsigned char>(token[0])));
 
         // true branch
-        if (range.second - range.first == 4 && input.m_String[range.first] == 't')
+        if (token.size() == 4 && first == 't')
         {
-            // Go through comparing grabbed arg to "true" char by char, bail if not the same
-            for (size_t i = range.first + 1; i < range.second; ++i)
-                if ((input.m_String[i] = char(std::tolower(input.m_String[i]))) != s_true[i - range.first])
-                    throw Exception(s_err_msg + std::string(", expected true"), ARG_PARSE_SUBSTR(range));
-            m_Value = true;
+            if (!Matches(token, "true"))
+                return MakeParseError(ParseErrorCode::EXPECTED_TRUE, range);
+            value = true;
         }
         // false branch
-        else if (range.second - range.first == 5 && input.m_String[range.first] == 'f')
+        else if (token.size() == 5 && first == 'f')
         {
-            // Go through comparing grabbed arg to "false" char by char, bail if not the same
-            for (size_t i = range.first + 1; i < range.second; ++i)
-                if ((input.m_String[i] = char(std::tolower(input.m_String[i]))) != s_false[i - range.first])
-                    throw Exception(s_err_msg + std::string(", expected false"), ARG_PARSE_SUBSTR(range));
-            m_Value = false;
+            if (!Matches(token, "false"))
+                return MakeParseError(ParseErrorCode::EXPECTED_FALSE, range);
+            value = false;
         }
         // anything else, not true or false
         else
-            throw Exception(s_err_msg, ARG_PARSE_SUBSTR(range));
+            return MakeParseError(ParseErrorCode::INVALID_BOOLEAN, range);
+
+        return ParseError();
     }
 
     /*!
@@ -293,28 +664,29 @@ namespace csys
     ARG_PARSE_BASE_SPEC(char)
     {
         // Grab the argument
-        auto range = input.NextPoi(start);
-        size_t len = range.second - range.first;
+        std::string_view token = ArgumentToken(input, range);
 
         // Check if its 3 or more letters
-        if (len > 2 || len <= 0)
-            throw Exception("Too many or no chars were given", ARG_PARSE_SUBSTR(range));
+        if (token.size() > 2 || token.empty())
+            return MakeParseError(ParseErrorCode::CHAR_COUNT, range);
         // potential reserved char
-        else if (len == 2)
+        else if (token.size() == 2)
         {
             // Check if the first char is \ and the second is a reserved char
-            if (!Reserved::IsEscaping(input.m_String, range.first))
-                throw Exception("Too many chars were given", ARG_PARSE_SUBSTR(range));
+            if (!Reserved::IsEscaping(token, 0))
+                return MakeParseError(ParseErrorCode::TOO_MANY_CHARS, range);
 
             // is correct
-            m_Value = input.m_String[range.first + 1];
+            value = token[1];
         }
         // if its one char and reserved
-        else if (Reserved::IsReservedChar(input.m_String[range.first]))
-            throw Exception(s_ErrMsgReserved, ARG_PARSE_SUBSTR(range));
+        else if (Reserved::IsReservedChar(token[0]))
+            return MakeParseError(ParseErrorCode::RESERVED_CHAR, range);
         // one char, not reserved
         else
-            m_Value = input.m_String[range.first];
+            value = token[0];
+
+        return ParseError();
     }
 
     /*!
@@ -323,96 +695,77 @@ namespace csys
      */
     ARG_PARSE_BASE_SPEC(unsigned char)
     {
-        // Grab the argument
-        auto range = input.NextPoi(start);
-        size_t len = range.second - range.first;
-
-        // Check if its 3 or more letters
-        if (len > 2 || len <= 0)
-            throw Exception("Too many or no chars were given", ARG_PARSE_SUBSTR(range));
-        // potential reserved char
-        else if (len == 2)
-        {
-            // Check if the first char is \ and the second is a reserved char
-            if (!Reserved::IsEscaping(input.m_String, range.first))
-                throw Exception("Too many chars were given", ARG_PARSE_SUBSTR(range));
-
-            // is correct
-            m_Value = static_cast<unsigned char>(input.m_String[range.first + 1]);
-        }
-        // if its one char and reserved
-        else if (Reserved::IsReservedChar(input.m_String[range.first]))
-            throw Exception(s_ErrMsgReserved, ARG_PARSE_SUBSTR(range));
-        // one char, not reserved
-        else
-            m_Value = static_cast<unsigned char>(input.m_String[range.first]);
+        char c = 0;
+        auto error = ArgumentParser<char>::ParseToken(input, range, c);
+        value = static_cast<unsigned char>(c);
+        return error;
     }
 
     /*!
      * \brief
      *      Template specialization for short argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(short, "signed short", std::stoi)
+    ARG_PARSE_GENERAL_SPEC(short, "signed short")
 
     /*!
      * \brief
      *      Template specialization for unsigned short argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(unsigned short, "unsigned short", std::stoul)
+    ARG_PARSE_GENERAL_SPEC(unsigned short, "unsigned short")
 
     /*!
      * \brief
      *      Template specialization for int argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(int, "signed int", std::stoi)
+    ARG_PARSE_GENERAL_SPEC(int, "signed int")
 
     /*!
      * \brief
      *      Template specialization for unsigned int argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(unsigned int, "unsigned int", std::stoul)
+    ARG_PARSE_GENERAL_SPEC(unsigned int, "unsigned int")
 
     /*!
      * \brief
      *      Template specialization for long argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(long, "long", std::stol)
+    ARG_PARSE_GENERAL_SPEC(long, "long")
 
     /*!
      * \brief
      *      Template specialization for unsigned long argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(unsigned long, "unsigned long", std::stoul)
+    ARG_PARSE_GENERAL_SPEC(unsigned long, "unsigned long")
 
     /*!
      * \brief
      *      Template specialization for long long argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(long long, "long long", std::stoll)
+    ARG_PARSE_GENERAL_SPEC(long long, "long long")
 
     /*!
      * \brief
      *      Template specialization for unsigned long long argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(unsigned long long, "unsigned long long", std::stoull)
+    ARG_PARSE_GENERAL_SPEC(unsigned long long, "unsigned long long")
 
     /*!
      * \brief
      *      Template specialization for float argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(float, "float", std::stof)
+    ARG_PARSE_GENERAL_SPEC(float, "float")
 
     /*!
      * \brief
      *      Template specialization for double argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(double, "double", std::stod)
+    ARG_PARSE_GENERAL_SPEC(double, "double")
 
     /*!
      * \brief
      *      Template specialization for long double argument parsing
      */
-    ARG_PARSE_GENERAL_SPEC(long double, "long double", std::stold)
+    ARG_PARSE_GENERAL_SPEC(long double, "long double")
 
     /*!
      * \brief
@@ -431,84 +784,80 @@ namespace csys
          *      Input to the command for this class to parse its argument
          * \param start
          *      Start of this argument
+         * \param value
+         *      Vector of data parsed
+         * \return
+         *      Parse error, empty on success
          */
-        ArgumentParser(String &input, size_t &start);
+        static ParseError Parse(std::string_view input, size_t &start, std::vector<T> &value)
+        {
+            return ParseToken(input, NextToken(input, start), value);
+        }
 
-        std::vector<T> m_Value;    //!< Vector of data parsed
+        /*!
+         * \brief
+         *      Grabs a vector argument of type T already split from 'input'
+         * \param input
+         *      Input to the command for this class to parse its argument
+         * \param range
+         *      Argument within 'input', as returned by NextToken
+         * \param value
+         *      Vector of data parsed
+         * \return
+         *      Parse error, empty on success
+         */
+        static ParseError ParseToken(std::string_view input, const std::pair<size_t, size_t> &range, std::vector<T> &value);
     };
 
     /*!
      * \brief
-     *      Grabs a vector argument of type T from 'input' starting from 'start'
+     *      Grabs a vector argument of type T already split from 'input'
      * \tparam T
      *      Type of vector
      * \param input
      *      Input to the command for this class to parse its argument
-     * \param start
-     *      Start of this argument
+     * \param range
+     *      Argument within 'input', as returned by NextToken
+     * \param value
+     *      Vector of data parsed
+     * \return
+     *      Parse error, empty on success
      */
     template<typename T>
-    ArgumentParser<std::vector<T>>::ArgumentParser(String &input, size_t &start)
+    ParseError ArgumentParser<std::vector<T>>::ParseToken(std::string_view input, const std::pair<size_t, size_t> &range,
+                                                          std::vector<T> &value)
     {
         // Clean out vector before use
-        m_Value.clear();
-
-        // Grab the start of the vector argument
-        auto range = input.NextPoi(start);
+        value.clear();
 
         // Empty
-        if (range.first == input.End()) return;
+        if (range.first >= input.size()) return ParseError();
 
         // Not starting with [
-        if (input.m_String[range.first] != '[')
-            throw Exception("Invalid vector argument missing opening [", ARG_PARSE_SUBSTR(range));
+        if (input[range.first] != '[')
+            return MakeParseError(ParseErrorCode::MISSING_OPENING_BRACKET, range);
 
-        // Erase [
-        input.m_String[range.first] = ' ';
+        // Elements never go passed the end of the vector, skip [
+        std::string_view vector = input.substr(0, range.second);
+        size_t pos = range.first + 1;
         while (true)
         {
-            // Get next argument in vector
-            range = input.NextPoi(range.first);
-
-            // No more, empty vector
-            if (range.first == input.End()) return;
-
-            // Is a nested vector, go deeper
-            else if (input.m_String[range.first] == '[')
-                m_Value.push_back(ArgumentParser<T>(input, range.first).m_Value);
-            else
-            {
-                // Find first non-escaped ]
-                range.second = input.m_String.find(']', range.first);
-                while (range.second != std::string::npos && Reserved::IsEscaped(input.m_String, range.second))
-                    range.second = input.m_String.find(']', range.second + 1);
-
-                // Check for closing ]
-                if (range.second == std::string::npos)
-                {
-                    range.second = input.m_String.size();
-                    throw Exception("Invalid vector argument missing closing ]", ARG_PARSE_SUBSTR(range));
-                }
-
-                // Erase ]
-                input.m_String[range.second] = ' ';
-                start = range.first;
-
-                // Parse all arguments contained within the vector
-                while (true)
-                {
-                    // If end of parsing, get out
-                    if ((range.first = input.NextPoi(range.first).first) >= range.second)
-                    {
-                        start = range.first;
-                        return;
-                    }
-
-                    // Parse argument and go to next
-                    m_Value.push_back(ArgumentParser<T>(input, start).m_Value);
-                    range.first = start;
-                }
-            }
+            // Go to the next element
+            pos = Scan::SkipSpace(vector, pos);
+
+            // No more, vector never closed
+            if (pos == vector.size())
+                return MakeParseError(ParseErrorCode::MISSING_CLOSING_BRACKET, {range.first, input.size()});
+
+            // Closing ]
+            if (vector[pos] == ']')
+                return ParseError();
+
+            // Parse element, a [ starts a nested vector and ] ends this one so elements are only scanned once
+            T element{};
+            if (auto error = ArgumentParser<T>::ParseToken(input, NextToken(vector, pos, true), element))
+                return error;
+            value.push_back(std::move(element));
         }
     }
 }
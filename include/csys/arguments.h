@@ -9,6 +9,7 @@
 #include "csys/string.h"
 #include "csys/exceptions.h"
 #include "csys/argument_parser.h"
+#include <string_view>
 #include <vector>
 
 namespace csys
@@ -22,10 +23,9 @@ namespace csys
     template<> \
     struct CSYS_API ArgData<TYPE> \
     { \
-      explicit ArgData(String name) : m_Name(std::move(name)), m_Value() {} \
+      explicit ArgData(String name) : m_Name(std::move(name)) {} \
       const String m_Name; \
-      String m_TypeName = TYPE_NAME; \
-      TYPE m_Value; \
+      const String m_TypeName = TYPE_NAME; \
     };
 
     using NULL_ARGUMENT = void (*)();    //!< Null argument typedef
@@ -38,7 +38,7 @@ namespace csys
 
     /*!
      * \brief
-     *      Wrapper around a given data type to name it
+     *      Name and type name of an argument of a given data type
      * \tparam T
      *      Type of data that must have a default constructor
      */
@@ -51,12 +51,11 @@ namespace csys
          * \param name
          *      Name of the argument
          */
-        explicit ArgData(String name) : m_Name(std::move(name)), m_Value()
+        explicit ArgData(String name) : m_Name(std::move(name))
         { }
 
-        const String m_Name = "";                  //!< Name of argument
-        String m_TypeName = "Unsupported Type";    //!< Name of type
-        T m_Value;                                 //!< Actual value
+        const String m_Name = "";                        //!< Name of argument
+        const String m_TypeName = "Unsupported Type";    //!< Name of type
     };
 
     //! Supported types
@@ -104,14 +103,14 @@ namespace csys
         explicit ArgData(String name) : m_Name(std::move(name))
         {}
 
-        const String m_Name;                                                                   //!< Name of argument
-        String m_TypeName = std::string("Vector_Of_") + ArgData<T>("").m_TypeName.m_String;    //!< Type name
-        std::vector<T> m_Value;                                                                //!< Vector of data
+        const String m_Name;                                                                         //!< Name of argument
+        const String m_TypeName = std::string("Vector_Of_") + ArgData<T>("").m_TypeName.m_String;    //!< Type name
     };
 
     /*!
      * \brief
-     *      Wrapper around an argument for use of parsing a command line
+     *      Description of an argument for use of parsing a command line. Parsed values are handed back to the caller
+     *      and never stored, so one argument can parse any number of command lines at once
      * \tparam T
      *      Data type
      */
@@ -144,24 +143,66 @@ namespace csys
 
         /*!
          * \brief
-         *      Grabs its own argument from the command line and sets its value
+         *      Grabs a value of this argument's type from the command line without storing it
          * \param input
-         *      Command line argument list
+         *      Command line argument list, never modified
          * \param start
          *      Start of its argument
+         * \param value
+         *      Parsed value
          * \return
-         *      Returns this
+         *      Parse error, empty on success
          */
-        Arg<T> &Parse(String &input, size_t &start)
+        static ParseError TryParseValue(std::string_view input, size_t &start, ValueType &value)
         {
-            size_t index = start;
+            auto token = NextToken(input, start);
 
             // Check if there are more arguments to be read in
-            if (input.NextPoi(index).first == input.End())
-                throw Exception("Not enough arguments were given", input.m_String);
-            // Set value grabbed from input aka command line argument
-            m_Arg.m_Value = ArgumentParser<ValueType>(input, start).m_Value;
-            return *this;
+            if (token.first == input.size() + 1)
+                return ParseError{ParseErrorCode::NOT_ENOUGH_ARGUMENTS, 0, input.size()};
+            return ArgumentParser<ValueType>::ParseToken(input, token, value);
+        }
+
+        /*!
+         * \brief
+         *      Takes a value of this argument's type from a command line already split without storing it
+         * \param input
+         *      Command line argument list, never modified
+         * \param tokens
+         *      Arguments of 'input' not taken yet
+         * \param value
+         *      Parsed value
+         * \return
+         *      Parse error, empty on success
+         */
+        static ParseError TryParseValue(std::string_view input, ArgumentTokens &tokens, ValueType &value)
+        {
+            std::pair<size_t, size_t> token;
+
+            // Check if there are more arguments to be read in
+            if (!tokens.Next(token))
+                return ParseError{ParseErrorCode::NOT_ENOUGH_ARGUMENTS, 0, input.size()};
+            return ArgumentParser<ValueType>::ParseToken(input, token, value);
+        }
+
+        /*!
+         * \brief
+         *      Grabs a value of this argument's type from the command line without storing it
+         * \param input
+         *      Command line argument list, never modified
+         * \param start
+         *      Start of its argument
+         * \return
+         *      Returns the parsed value
+         * \note
+         *      Throws csys::Exception on failure
+         */
+        static ValueType ParseValue(std::string_view input, size_t &start)
+        {
+            ValueType value{};
+            if (auto error = TryParseValue(input, start, value))
+                CSYS_THROW(Exception(error.Message(input)));
+            return value;
         }
 
         /*!
@@ -170,12 +211,12 @@ namespace csys
          * \return
          *      Returns a string containing the arugment's info
          */
-        std::string Info()
+        [[nodiscard]] std::string Info() const
         {
             return std::string(" [") + m_Arg.m_Name.m_String + ":" + m_Arg.m_TypeName.m_String + "]";
         }
 
-        ArgData<ValueType> m_Arg;    //!< Data relating to this argument
+        const ArgData<ValueType> m_Arg;    //!< Data relating to this argument
     };
 
     /*!
@@ -186,6 +227,41 @@ namespace csys
     template<>
     struct CSYS_API Arg<NULL_ARGUMENT>
     {
+        /*!
+         * \brief
+         *      Checks if the input starting from param 'start' is all whitespace or not
+         * \param input
+         *      Command line argument list
+         * \param start
+         *      Start of its argument
+         * \return
+         *      Parse error, empty if only whitespace was left
+         */
+        ParseError TryParse(std::string_view input, size_t &start) const
+        {
+            if (String::NextPoi(input, start).first != input.size() + 1)
+                return ParseError{ParseErrorCode::TOO_MANY_ARGUMENTS, 0, input.size()};
+            return ParseError();
+        }
+
+        /*!
+         * \brief
+         *      Checks if every argument of a command line already split was taken
+         * \param input
+         *      Command line argument list
+         * \param tokens
+         *      Arguments of 'input' not taken yet
+         * \return
+         *      Parse error, empty if no arguments were left
+         */
+        ParseError TryParse(std::string_view input, ArgumentTokens &tokens) const
+        {
+            std::pair<size_t, size_t> token;
+            if (tokens.Next(token))
+                return ParseError{ParseErrorCode::TOO_MANY_ARGUMENTS, 0, input.size()};
+            return ParseError();
+        }
+
         /*!
          * \brief
          *      Checks if the input starting from param 'start' is all whitespace or not
@@ -195,13 +271,32 @@ namespace csys
          *      Start of its argument
          * \return
          *      Returns this
+         * \note
+         *      Throws csys::Exception if arguments are left
          */
-        Arg<NULL_ARGUMENT> &Parse(String &input, size_t &start)
+        const Arg<NULL_ARGUMENT> &Parse(std::string_view input, size_t &start) const
         {
-            if (input.NextPoi(start).first != input.End())
-                throw Exception("Too many arguments were given", input.m_String);
+            if (auto error = TryParse(input, start))
+                CSYS_THROW(Exception(error.Message(input)));
             return *this;
         }
+
+        /*!
+         * \brief
+         *      Checks if the input starting from param 'start' is all whitespace or not
+         * \param input
+         *      Command line argument list
+         * \param start
+         *      Start of its argument
+         * \return
+         *      Returns this
+         * \note
+         *      Throws csys::Exception if arguments are left
+         */
+        const Arg<NULL_ARGUMENT> &Parse(const String &input, size_t &start) const
+        {
+            return Parse(std::string_view(input.m_String), start);
+        }
     };
 }
 
@@ -7,8 +7,13 @@
 #pragma once
 
 #include "csys/api.h"
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace csys
@@ -17,7 +22,7 @@ namespace csys
     // TODO: Todo add max word suggestion depth.
     // TODO: Only use "const char *" or "std::string" in csys. (On stl containers use iterators - SLOW). (Need to add std::string version)
 
-    //!< Auto complete ternary search tree.
+    //!< Auto complete ternary search tree, nodes are stored contiguously and linked by index.
     class CSYS_API AutoComplete
     {
     public:
@@ -26,29 +31,34 @@ namespace csys
         using r_sVector = std::vector<std::string> &;
         using sVector = std::vector<std::string>;
 
+        using NodeIndex = uint32_t;                  //!< Index of a node in the node pool.
+        static constexpr NodeIndex NIL = 0;          //!< Null node index. (Slot 0 of the pool is never used)
+
         //!< Autocomplete node.
         struct ACNode
         {
-            explicit ACNode(const char data, bool isWord = false) : m_Data(data), m_IsWord(isWord), m_Less(nullptr), m_Equal(nullptr), m_Greater(nullptr)
-            {};
-
-            explicit ACNode(const char &&data, bool isWord = false) : m_Data(data), m_IsWord(isWord), m_Less(nullptr), m_Equal(nullptr), m_Greater(nullptr)
+            explicit ACNode(const char data, bool isWord = false) : m_Data(data), m_IsWord(isWord), m_Less(NIL), m_Equal(NIL), m_Greater(NIL)
             {};
 
-            ~ACNode()
-            {
-                delete m_Less;
-                delete m_Equal;
-                delete m_Greater;
-            };
+            char m_Data;             //!< Node data.
+            bool m_IsWord;           //!< Flag to determine if node is the end of a word.
+            NodeIndex m_Less;        //!< Left child.
+            NodeIndex m_Equal;       //!< Middle child. (Next free node while on the free list)
+            NodeIndex m_Greater;     //!< Right child.
+        };
 
-            char m_Data;          //!< Node data.
-            bool m_IsWord;        //!< Flag to determine if node is the end of a word.
-            ACNode *m_Less;       //!< Left pointer.
-            ACNode *m_Equal;      //!< Middle pointer.
-            ACNode *m_Greater;    //!< Right pointer.
+        //!< Shape of the tree, to check how balanced it is.
+        struct Stats
+        {
+            size_t m_Words = 0;            //!< Word count
+            size_t m_Nodes = 0;            //!< Node count
+            size_t m_MaxDepth = 0;         //!< Most nodes visited to find a word
+            double m_AverageDepth = 0;     //!< Average nodes visited to find a word
+            double m_AverageLength = 0;    //!< Average word length, the fewest nodes a lookup can visit
         };
 
+        class Cursor;
+
         /*!
          * \brief Default Constructor
          */
@@ -60,7 +70,7 @@ namespace csys
          * \param tree
          *      Tree to be copied
          */
-        AutoComplete(const AutoComplete &tree);
+        AutoComplete(const AutoComplete &tree) = default;
 
         /*!
          * \brief
@@ -68,7 +78,7 @@ namespace csys
          * \param rhs
          *      Tree to be copied
          */
-        AutoComplete(AutoComplete &&rhs) = default;
+        AutoComplete(AutoComplete &&rhs) noexcept;
 
         /*!
          * \brief
@@ -88,10 +98,11 @@ namespace csys
          * \return
          *      Self
          */
-        AutoComplete& operator=(AutoComplete&& rhs) = default;
+        AutoComplete& operator=(AutoComplete&& rhs) noexcept;
 
         /*!
-         *
+         * \brief
+         *      Builds a balanced tree from every string at once, whatever their order
          * \tparam inputType
          *      String input type
          * \param[in] il
@@ -100,14 +111,12 @@ namespace csys
         template<typename inputType>
         AutoComplete(std::initializer_list<inputType> il)
         {
-            for (const auto &item : il)
-            {
-                Insert(item);
-            }
+            Build(sVector(il.begin(), il.end()));
         }
 
         /*!
-         *
+         * \brief
+         *      Builds a balanced tree from every string at once, whatever their order
          * \tparam T
          *      Container type
          * \param[in] items
@@ -116,17 +125,14 @@ namespace csys
         template<typename T>
         explicit AutoComplete(const T &items)
         {
-            for (const auto &item : items)
-            {
-                Insert(item);
-            }
+            Build(sVector(std::begin(items), std::end(items)));
         }
 
         /*!
          * /brief
          *      Destructor
          */
-        ~AutoComplete();
+        ~AutoComplete() = default;
 
         /*!
          * \brief
@@ -144,6 +150,14 @@ namespace csys
          */
         [[nodiscard]] size_t Count() const;
 
+        /*!
+         * \brief
+         *      Measure the depth of every word
+         * \return
+         *      Tree shape statistics
+         */
+        [[nodiscard]] Stats Statistics() const;
+
         /*!
          * \brief
          *      Search if the given word is in the tree
@@ -181,42 +195,53 @@ namespace csys
         template<typename strType>
         void Insert(const strType &word)
         {
-            ACNode **ptr = &m_Root;
+            // Words already in the tree leave shared nodes shared.
+            if (FindWord(std::string_view(word)) != NIL) return;
+
+            // Links are re-read after every allocation, as the pool may have moved.
+            NodeIndex parent = NIL;
+            NodeIndex ACNode::*link = &ACNode::m_Equal;
+            auto ptr = word;
+            auto &nodes = m_Nodes.Write();
             ++m_Count;
+            ++m_Version;
 
-            while (*word != '\0')
+            while (*ptr != '\0')
             {
                 // Insert char into tree.
-                if (*ptr == nullptr)
+                NodeIndex index = Link(parent, link);
+                if (index == NIL)
                 {
-                    *ptr = new ACNode(*word);
-                    ++m_Size;
+                    index = NewNode(*ptr);
+                    Link(parent, link) = index;
                 }
 
                 // Traverse tree.
-                if (*word < (*ptr)->m_Data)
+                ACNode &node = nodes[index];
+                if (*ptr < node.m_Data)
                 {
-                    ptr = &(*ptr)->m_Less;
+                    link = &ACNode::m_Less;
                 }
-                else if (*word == (*ptr)->m_Data)
+                else if (*ptr == node.m_Data)
                 {
                     // String is already in tree, therefore only mark as word.
-                    if (*(word + 1) == '\0')
+                    if (*(ptr + 1) == '\0')
                     {
-                        if ((*ptr)->m_IsWord)
+                        if (node.m_IsWord)
                             --m_Count;
 
-                        (*ptr)->m_IsWord = true;
+                        node.m_IsWord = true;
                     }
 
                     // Advance.
-                    ptr = &(*ptr)->m_Equal;
-                    ++word;
+                    link = &ACNode::m_Equal;
+                    ++ptr;
                 }
                 else
                 {
-                    ptr = &(*ptr)->m_Greater;
+                    link = &ACNode::m_Greater;
                 }
+                parent = index;
             }
         }
 
@@ -228,6 +253,13 @@ namespace csys
          */
         void Remove(const std::string &word);
 
+        /*!
+         * \brief
+         *      Rebuilds the tree balanced, as words inserted in sorted order turn sibling links into long chains.
+         *      Hit counters are kept, cursors have to resynchronize
+         */
+        void Rebalance();
+
         /*!
          * \brief
          *      Retrieve suggestions that match the given prefix
@@ -241,39 +273,41 @@ namespace csys
         template<typename strType>
         void Suggestions(const strType &prefix, r_sVector ac_options)
         {
-            ACNode *ptr = m_Root;
-            auto temp = prefix;
+            NodeIndex index = m_Root;
+            auto ptr = prefix;
 
             // Traverse tree and check if prefix exists.
-            while (ptr)
+            while (index != NIL)
             {
-                if (*prefix < ptr->m_Data)
+                const ACNode &node = m_Nodes[index];
+                if (*ptr < node.m_Data)
                 {
-                    ptr = ptr->m_Less;
+                    index = node.m_Less;
                 }
-                else if (*prefix == ptr->m_Data)
+                else if (*ptr == node.m_Data)
                 {
                     // Prefix exists in tree.
-                    if (*(prefix + 1) == '\0')
+                    if (*(ptr + 1) == '\0')
                         break;
 
-                    ptr = ptr->m_Equal;
-                    ++prefix;
+                    index = node.m_Equal;
+                    ++ptr;
                 }
                 else
                 {
-                    ptr = ptr->m_Greater;
+                    index = node.m_Greater;
                 }
             }
 
-            // Already a word. (No need to auto complete).
-            if (ptr && ptr->m_IsWord) return;
-
             // Prefix is not in tree.
-            if (!ptr) return;
+            if (index == NIL) return;
+
+            // Already a word. (No need to auto complete).
+            if (m_Nodes[index].m_IsWord) return;
 
             // Retrieve auto complete options.
-            SuggestionsAux(ptr->m_Equal, ac_options, temp);
+            std::string buffer(prefix);
+            SuggestionsAux(m_Nodes[index].m_Equal, ac_options, buffer);
         }
 
 
@@ -339,7 +373,434 @@ namespace csys
          */
         std::unique_ptr<sVector> Suggestions(const char *prefix);
 
+        /*!
+         * \brief
+         *      Visits the first suggestions matching the given prefix in alphabetical order, without collecting them
+         * \tparam Visitor
+         *      Callable taking a std::string_view
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup (Empty visits every word)
+         * \param[in] max_results
+         *      Maximum number of suggestions to visit
+         * \param[in] visitor
+         *      Called with each suggestion, only valid during the call
+         * \return
+         *      Number of suggestions visited
+         */
+        template<typename Visitor>
+        size_t Suggestions(std::string_view prefix, size_t max_results, Visitor &&visitor) const
+        {
+            return VisitSuggestions(m_Nodes.data(), m_Root, prefix, max_results, visitor);
+        }
+
+        /*!
+         * \brief
+         *      Counts the suggestions matching the given prefix
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup (Empty counts every word)
+         * \return
+         *      Number of suggestions the visitor overload of Suggestions would visit without a limit
+         */
+        [[nodiscard]] size_t SuggestionCount(std::string_view prefix) const;
+
+        /*!
+         * \brief
+         *      Retrieve words within an edit distance of the given query, tolerating typos
+         * \param[in] query
+         *      Possibly misspelled word
+         * \param[in] max_distance
+         *      Maximum number of insertions, deletions, substitutions and adjacent transpositions
+         * \param[in] max_results
+         *      Maximum number of words retrieved
+         * \param[out] ac_options
+         *      Found words, closest first, then shortest, then alphabetical
+         */
+        void FuzzySuggestions(std::string_view query, size_t max_distance, size_t max_results, r_sVector ac_options) const;
+
+        /*!
+         * \brief
+         *      Start keeping a hit counter per word, used to rank suggestions. Done by the first Hit otherwise
+         */
+        void EnableHits();
+
+        /*!
+         * \brief
+         *      Check if hit counters are kept
+         * \return
+         *      True once enabled
+         */
+        [[nodiscard]] bool HitsEnabled() const;
+
+        /*!
+         * \brief
+         *      Record uses of a word
+         * \param[in] word
+         *      Word used
+         * \param[in] count
+         *      Number of uses to add (Counters saturate)
+         * \return
+         *      False if the word is not in the tree, nothing is recorded
+         */
+        bool Hit(std::string_view word, uint32_t count = 1);
+
+        /*!
+         * \brief
+         *      Get the uses recorded for a word
+         * \param[in] word
+         *      Word to look up
+         * \return
+         *      Hit counter, 0 if the word is not in the tree or counters aren't kept
+         */
+        [[nodiscard]] uint32_t Hits(std::string_view word) const;
+
+        /*!
+         * \brief
+         *      Reset every hit counter to 0, counters are still kept
+         */
+        void ClearHits();
+
+        /*!
+         * \brief
+         *      Retrieve the most used suggestions matching the given prefix, without scanning every completion
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup (Empty ranks every word)
+         * \param[in] max_results
+         *      Maximum number of suggestions retrieved
+         * \param[out] ac_options
+         *      Found suggestions, most hits first, then alphabetical
+         */
+        void RankedSuggestions(std::string_view prefix, size_t max_results, r_sVector ac_options) const;
+
     protected:
+        friend class CompactAutoComplete;
+
+        /*!
+         * \brief
+         *      Vector shared by copies of a tree until one of them modifies it, so copying a tree is O(1). Elements
+         *      that were ever shared are never written in place: each tree copies them on its first write after a
+         *      copy (O(n) once, there is no path copying), then writes its own copy in place
+         * \tparam T
+         *      Element type
+         */
+        template<typename T>
+        class SharedVector
+        {
+        public:
+            SharedVector() = default;
+
+            explicit SharedVector(std::vector<T> items) : m_Block(std::make_shared<Block>())
+            {
+                m_Block->m_Items = std::move(items);
+            }
+
+            SharedVector(const SharedVector &rhs) : m_Block(rhs.m_Block)
+            {
+                Share();
+            }
+
+            SharedVector(SharedVector &&rhs) noexcept = default;
+
+            SharedVector &operator=(const SharedVector &rhs)
+            {
+                m_Block = rhs.m_Block;
+                Share();
+                return *this;
+            }
+
+            SharedVector &operator=(SharedVector &&rhs) noexcept = default;
+
+            // Read access, never copies.
+            const T &operator[](size_t index) const { return m_Block->m_Items[index]; }
+            [[nodiscard]] const T *data() const { return m_Block ? m_Block->m_Items.data() : nullptr; }
+            [[nodiscard]] size_t size() const { return m_Block ? m_Block->m_Items.size() : 0; }
+            [[nodiscard]] bool empty() const { return size() == 0; }
+            void clear() { m_Block.reset(); }
+
+            /*!
+             * \brief
+             *      Write access, copies the elements first if they were ever shared
+             * \return
+             *      Elements owned by this tree only, valid until the next copy or clear
+             */
+            std::vector<T> &Write()
+            {
+                if (!m_Block)
+                    m_Block = std::make_shared<Block>();
+                else if (m_Block->m_Shared.load(std::memory_order_acquire))
+                {
+                    // Same headroom as the shared elements, the write is often an append.
+                    auto block = std::make_shared<Block>();
+                    block->m_Items.reserve(m_Block->m_Items.capacity());
+                    block->m_Items.assign(m_Block->m_Items.begin(), m_Block->m_Items.end());
+                    m_Block = std::move(block);
+                }
+                return m_Block->m_Items;
+            }
+
+        private:
+            //!< Elements and their sharing state.
+            struct Block
+            {
+                std::vector<T> m_Items;                 //!< Elements
+                std::atomic<bool> m_Shared{false};      //!< Set once a copy refers to the block, never cleared
+            };
+
+            // Mark elements as shared by a copy (Safe while other threads copy the same source).
+            void Share()
+            {
+                if (m_Block)
+                    m_Block->m_Shared.store(true, std::memory_order_release);
+            }
+
+            std::shared_ptr<Block> m_Block;    //!< Elements (Null when empty)
+        };
+
+        //!< Hit counters of a node.
+        struct NodeHits
+        {
+            uint32_t m_Word = 0;     //!< Uses of the word ending at the node
+            uint32_t m_Max = 0;      //!< Highest m_Word of the node and every node below it (Upper bound after removals)
+        };
+
+        /*!
+         * \brief
+         *      Hit counters of the nodes that were hit, in an open addressed table. Copies share the table like the node
+         *      pool, and it stays empty until the first hit
+         */
+        class HitTable
+        {
+        public:
+            /*!
+             * \brief
+             *      Get the counters of a node
+             * \param index
+             *      Node
+             * \return
+             *      Counters, zero if the node has none
+             */
+            [[nodiscard]] NodeHits Get(NodeIndex index) const;
+
+            /*!
+             * \brief
+             *      Set the counters of a node, zero counters of a node without any aren't stored
+             * \param index
+             *      Node (Not NIL)
+             * \param hits
+             *      Counters
+             */
+            void Set(NodeIndex index, const NodeHits &hits);
+
+            /*!
+             * \brief
+             *      Drop every counter
+             */
+            void clear();
+
+        private:
+            //!< Counters of a node.
+            struct Slot
+            {
+                NodeIndex m_Node = NIL;    //!< Node, NIL for a free slot
+                NodeHits m_Hits;           //!< Counters of the node
+            };
+
+            /*!
+             * \brief
+             *      Make room for the counters of some nodes
+             * \param count
+             *      Node count
+             */
+            void Reserve(size_t count);
+
+            /*!
+             * \brief
+             *      Find the slot of a node, or the free slot it would go in
+             * \param index
+             *      Node
+             * \return
+             *      Slot position (m_Slots must not be empty)
+             */
+            [[nodiscard]] size_t Probe(NodeIndex index) const;
+
+            SharedVector<Slot> m_Slots;    //!< Power of two slots, linearly probed
+            size_t m_Used = 0;             //!< Slots holding a node
+        };
+
+        static constexpr size_t s_HitReserve = 64;    //!< Counters reserved by the first hit, dispatching rarely allocates
+
+        //!< Pending subtree or word of a ranked search.
+        struct RankedEntry
+        {
+            uint32_t m_Bound;        //!< Highest hit counter the entry can hold
+            NodeIndex m_Node;        //!< Subtree root, NIL for a word
+            size_t m_Depth;          //!< Length of the path leading to m_Node
+            std::string m_Key;       //!< Word, or the path followed by the smallest character the subtree may start with
+        };
+
+        /*!
+         * \brief
+         *      State of a fuzzy search
+         */
+        struct FuzzySearch
+        {
+            std::string_view m_Query;                              //!< Word being looked for
+            size_t m_MaxDistance;                                  //!< Maximum edit distance of a match
+            std::vector<size_t> m_Rows;                            //!< Edit distance rows, one per path length
+            std::string m_Buffer;                                  //!< Current path
+            std::vector<std::pair<size_t, std::string>> m_Matches; //!< Matches and their distance
+        };
+
+        /*!
+         * \brief
+         *      Retrieve words within an edit distance of a query, see FuzzySuggestions
+         */
+        static void FuzzySuggestions(const ACNode *nodes, NodeIndex root, std::string_view query, size_t max_distance,
+                                     size_t max_results, r_sVector ac_options);
+
+        /*!
+         * \brief
+         *      Collects matches of a subtree, skipping subtrees that can't get within the maximum distance
+         * \param nodes
+         *      Node array
+         * \param root
+         *      Subtree root
+         * \param depth
+         *      Length of the path leading to root
+         * \param search
+         *      Search state
+         */
+        static void FuzzyAux(const ACNode *nodes, NodeIndex root, size_t depth, FuzzySearch &search);
+
+        /*!
+         * \brief
+         *      Finds the subtree holding the completions of a prefix
+         * \param nodes
+         *      Node array
+         * \param root
+         *      Root node
+         * \param prefix
+         *      Prefix to complete
+         * \return
+         *      Subtree root, NIL if the prefix isn't in the tree or is already a word
+         */
+        static NodeIndex FindCompletions(const ACNode *nodes, NodeIndex root, std::string_view prefix);
+
+        /*!
+         * \brief
+         *      Visits the first completions of a prefix, see Suggestions
+         */
+        template<typename Visitor>
+        static size_t VisitSuggestions(const ACNode *nodes, NodeIndex root, std::string_view prefix, size_t max_results,
+                                       Visitor &visitor)
+        {
+            if (max_results == 0) return 0;
+
+            // Subtree of completions.
+            if (!prefix.empty())
+                root = FindCompletions(nodes, root, prefix);
+
+            // Scratch buffer shared by every suggestion.
+            std::string buffer(prefix);
+            size_t remaining = max_results;
+            VisitAux(nodes, root, buffer, remaining, visitor);
+            return max_results - remaining;
+        }
+
+        /*!
+         * \brief
+         *      Visits words in alphabetical order until none remain
+         * \param nodes
+         *      Node array
+         * \param root
+         *      Subtree root
+         * \param buffer
+         *      Characters leading to root, restored before returning
+         * \param remaining
+         *      Number of words left to visit
+         * \param visitor
+         *      Called with each word
+         */
+        template<typename Visitor>
+        static void VisitAux(const ACNode *nodes, NodeIndex root, std::string &buffer, size_t &remaining, Visitor &visitor)
+        {
+            if (root == NIL) return;
+            const ACNode &node = nodes[root];
+
+            // Left branch.
+            VisitAux(nodes, node.m_Less, buffer, remaining, visitor);
+            if (remaining == 0) return;
+
+            // Word ends here.
+            buffer.push_back(node.m_Data);
+            if (node.m_IsWord)
+            {
+                visitor(std::string_view(buffer));
+                --remaining;
+            }
+
+            // Middle branch.
+            if (remaining != 0)
+                VisitAux(nodes, node.m_Equal, buffer, remaining, visitor);
+            buffer.pop_back();
+            if (remaining == 0) return;
+
+            // Right branch.
+            VisitAux(nodes, node.m_Greater, buffer, remaining, visitor);
+        }
+
+        /*!
+         * \brief
+         *      Counts words in a subtree
+         * \param nodes
+         *      Node array
+         * \param root
+         *      Subtree root
+         * \return
+         *      Word count
+         */
+        static size_t CountAux(const ACNode *nodes, NodeIndex root);
+
+        /*!
+         * \brief
+         *      Replaces the tree by a balanced one holding the given words
+         * \param words
+         *      Words of the tree, in any order (Duplicates and empty strings are ignored)
+         * \param hits
+         *      Hit counter of each word once sorted (Empty if none are kept)
+         */
+        void Build(sVector words, const std::vector<uint32_t> &hits = {});
+
+        /*!
+         * \brief
+         *      Builds a balanced subtree, the middle word's character splits the rest into less and greater siblings
+         * \param words
+         *      Sorted unique words
+         * \param hits
+         *      Hit counter of each word (Empty if none are kept)
+         * \param begin
+         *      First word of the subtree
+         * \param end
+         *      One past the last word of the subtree
+         * \param depth
+         *      Length of the prefix the words share, every word is longer
+         * \return
+         *      Subtree root
+         */
+        NodeIndex BuildAux(const sVector &words, const std::vector<uint32_t> &hits, size_t begin, size_t end, size_t depth);
+
+        /*!
+         * \brief
+         *      Adds the depth and length of every word of a subtree to the statistics
+         * \param root
+         *      Subtree root
+         * \param depth
+         *      Nodes visited to reach root
+         * \param length
+         *      Length of the path leading to root
+         * \param[in/out] stats
+         *      Statistics, the averages hold sums until the walk is done
+         */
+        void StatisticsAux(NodeIndex root, size_t depth, size_t length, Stats &stats) const;
 
         /*!
          * \param[in] root
@@ -347,9 +808,9 @@ namespace csys
          * \param[out] ac_options
          *      Vector of found suggestions
          * \param[in] buffer
-         *      Prefix buffer
+         *      Prefix buffer, restored before returning
          */
-        void SuggestionsAux(ACNode *root, r_sVector ac_options, std::string buffer);
+        void SuggestionsAux(NodeIndex root, r_sVector ac_options, std::string &buffer);
 
         /*!
          * \brief
@@ -361,21 +822,224 @@ namespace csys
          * \return
          *      If node is word
          */
-        bool RemoveAux(ACNode *root, const char *word);
+        bool RemoveAux(NodeIndex root, const char *word);
+
+        /*!
+         * \brief
+         *      Finds the node a word ends at
+         * \param word
+         *      Word to look up
+         * \return
+         *      Word node, NIL if the word is not in the tree
+         */
+        [[nodiscard]] NodeIndex FindWord(std::string_view word) const;
+
+        /*!
+         * \brief
+         *      Recomputes the highest hit counter below a node from its children
+         * \param index
+         *      Node whose children are up to date
+         */
+        void RefreshHits(NodeIndex index);
+
+        /*!
+         * \brief
+         *      Takes a node from the free list, or appends one to the pool
+         * \param data
+         *      Node data
+         * \return
+         *      Index of the new node
+         */
+        NodeIndex NewNode(char data);
 
         /*!
          * \brief
-         *      Clone acNode and all its children
-         * \param src
-         *      Node to copy from
-         * \param dest
-         *      Where new node will be stored
+         *      Returns a node to the free list
+         * \param index
+         *      Node to be freed, must have no children
+         */
+        void FreeNode(NodeIndex index);
+
+        /*!
+         * \brief
+         *      Gets a child link
+         * \param parent
+         *      Parent node, NIL for the root link
+         * \param link
+         *      Child link of the parent (Ignored for the root)
+         * \return
+         *      Reference to the link, invalidated by NewNode
+         */
+        NodeIndex &Link(NodeIndex parent, NodeIndex ACNode::*link)
+        {
+            return parent == NIL ? m_Root : m_Nodes.Write()[parent].*link;
+        }
+
+        SharedVector<ACNode> m_Nodes{std::vector<ACNode>(1, ACNode('\0'))};    //!< Node pool (Slot 0 is reserved for NIL)
+        NodeIndex m_Root = NIL;                                                //!< Ternary Search Tree Root node
+        NodeIndex m_FreeList = NIL;                                            //!< First free node in the pool
+        size_t m_Size = 0;                                                     //!< Node count
+        size_t m_Count = 0;                                                    //!< Word count
+        uint64_t m_Version = 0;                                                //!< Changed by every modification, checked by cursors
+        HitTable m_Hits;                                                       //!< Hit counters (Empty if not kept)
+        bool m_HitsEnabled = false;                                            //!< Flag to determine if hit counters are kept
+    };
+
+    /*!
+     * \brief
+     *      Prefix being typed into an autocomplete tree. Remembers the node matched by every character, so adding or
+     *      removing one doesn't walk the tree from the root again
+     *
+     * \note
+     *      The tree must outlive the cursor. Cursors notice when the tree is modified and match their prefix again
+     */
+    class CSYS_API AutoComplete::Cursor
+    {
+    public:
+
+        /*!
+         * \brief
+         *      Creates a cursor with an empty prefix
+         * \param tree
+         *      Tree to be searched
+         */
+        explicit Cursor(const AutoComplete &tree);
+
+        /*!
+         * \brief
+         *      Appends a character to the prefix
+         * \param c
+         *      Character typed
+         * \return
+         *      False if the new prefix is not in the tree
+         */
+        bool Push(char c);
+
+        /*!
+         * \brief
+         *      Removes the last character of the prefix
+         * \return
+         *      False if the prefix was empty
+         */
+        bool Pop();
+
+        /*!
+         * \brief
+         *      Empties the prefix
+         */
+        void Clear();
+
+        /*!
+         * \brief
+         *      Get the prefix
+         * \return
+         *      Characters pushed and not popped
+         */
+        [[nodiscard]] const std::string &Prefix() const;
+
+        /*!
+         * \brief
+         *      Check if the tree is unmodified since the cursor last matched its prefix
+         * \return
+         *      False if the next call will match the prefix again
+         */
+        [[nodiscard]] bool Valid() const;
+
+        /*!
+         * \brief
+         *      Check if the prefix is in the tree
+         * \return
+         *      True if nodes of the tree spell the prefix (Always for an empty prefix)
+         */
+        bool Matches();
+
+        /*!
+         * \brief
+         *      Check if the prefix is a word
+         * \return
+         *      True if the prefix is a word of the tree
+         */
+        bool IsWord();
+
+        /*!
+         * \brief
+         *      Pushes the characters every suggestion shares, as Suggestions(std::string &, r_sVector, true) completes
+         *      its prefix
+         * \return
+         *      Number of characters pushed
+         */
+        size_t Complete();
+
+        /*!
+         * \brief
+         *      Visits the first suggestions matching the prefix in alphabetical order, see AutoComplete::Suggestions
+         * \tparam Visitor
+         *      Callable taking a std::string_view
+         * \param[in] max_results
+         *      Maximum number of suggestions to visit
+         * \param[in] visitor
+         *      Called with each suggestion, only valid during the call
+         * \return
+         *      Number of suggestions visited
+         */
+        template<typename Visitor>
+        size_t Suggestions(size_t max_results, Visitor &&visitor)
+        {
+            if (max_results == 0) return 0;
+
+            NodeIndex root = Completions();
+            std::string buffer(m_Prefix);
+            size_t remaining = max_results;
+            VisitAux(m_Tree->m_Nodes.data(), root, buffer, remaining, visitor);
+            return max_results - remaining;
+        }
+
+        /*!
+         * \brief
+         *      Retrieve suggestions that match the prefix
+         * \param[out] ac_options
+         *      Vector of found suggestions
+         */
+        void Suggestions(r_sVector ac_options);
+
+        /*!
+         * \brief
+         *      Counts the suggestions matching the prefix
+         * \return
+         *      Number of suggestions the visitor overload of Suggestions would visit without a limit
+         */
+        size_t SuggestionCount();
+
+    protected:
+
+        /*!
+         * \brief
+         *      Matches the prefix again if the tree was modified
+         */
+        void Sync();
+
+        /*!
+         * \brief
+         *      Finds the node matching a character of the prefix
+         * \param i
+         *      Position of the character, the nodes of the previous ones must be matched
+         * \return
+         *      Matching node, NIL if none
+         */
+        [[nodiscard]] NodeIndex Step(size_t i) const;
+
+        /*!
+         * \brief
+         *      Get the subtree holding the completions of the prefix, as FindCompletions
+         * \return
+         *      Subtree root, NIL if the prefix isn't in the tree or is already a word
          */
-        void DeepClone(ACNode *src, ACNode *&dest);
+        NodeIndex Completions();
 
-        ACNode *m_Root = nullptr;    //!< Ternary Search Tree Root node
-        size_t m_Size = 0;           //!< Node count
-        size_t m_Count = 0;          //!< Word count
+        const AutoComplete *m_Tree;      //!< Searched tree
+        uint64_t m_Version;              //!< Tree version the path was matched against
+        std::string m_Prefix;            //!< Characters pushed
+        std::vector<NodeIndex> m_Path;   //!< Node matching each character of m_Prefix (NIL from the first mismatch)
     };
 }
 
@@ -9,20 +9,29 @@
 
 #endif
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
 namespace csys
 {
     ///////////////////////////////////////////////////////////////////////////
     // Constructor/Destructors ////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 
-    CSYS_INLINE AutoComplete::~AutoComplete()
-    {
-        delete m_Root;
-    }
-
-    CSYS_INLINE AutoComplete::AutoComplete(const AutoComplete &tree) : m_Size(tree.m_Size), m_Count(tree.m_Count)
+    CSYS_INLINE AutoComplete::AutoComplete(AutoComplete &&rhs) noexcept : m_Nodes(std::move(rhs.m_Nodes)),
+                                                                          m_Root(std::exchange(rhs.m_Root, NIL)),
+                                                                          m_FreeList(std::exchange(rhs.m_FreeList, NIL)),
+                                                                          m_Size(std::exchange(rhs.m_Size, 0)),
+                                                                          m_Count(std::exchange(rhs.m_Count, 0)),
+                                                                          m_Version(rhs.m_Version),
+                                                                          m_Hits(std::move(rhs.m_Hits)),
+                                                                          m_HitsEnabled(std::exchange(rhs.m_HitsEnabled, false))
     {
-        DeepClone(tree.m_Root, m_Root);
+        // Source is left empty.
+        rhs.m_Nodes.clear();
+        rhs.m_Hits.clear();
+        ++rhs.m_Version;
     }
 
     CSYS_INLINE AutoComplete &AutoComplete::operator=(const AutoComplete &rhs)
@@ -30,13 +39,36 @@ namespace csys
         // Prevent self assignment.
         if (&rhs == this) return *this;
 
-        // Clean.
-        delete m_Root;
-
-        // Copy from source tree.
-        DeepClone(rhs.m_Root, m_Root);
+        // Cursors of either tree must not take the new content as unmodified.
+        m_Nodes = rhs.m_Nodes;
+        m_Root = rhs.m_Root;
+        m_FreeList = rhs.m_FreeList;
         m_Size = rhs.m_Size;
         m_Count = rhs.m_Count;
+        m_Version = std::max(m_Version, rhs.m_Version) + 1;
+        m_Hits = rhs.m_Hits;
+        m_HitsEnabled = rhs.m_HitsEnabled;
+
+        return *this;
+    }
+
+    CSYS_INLINE AutoComplete &AutoComplete::operator=(AutoComplete &&rhs) noexcept
+    {
+        // Prevent self assignment.
+        if (&rhs == this) return *this;
+
+        // Source is left empty.
+        m_Nodes = std::move(rhs.m_Nodes);
+        rhs.m_Nodes.clear();
+        m_Root = std::exchange(rhs.m_Root, NIL);
+        m_FreeList = std::exchange(rhs.m_FreeList, NIL);
+        m_Size = std::exchange(rhs.m_Size, 0);
+        m_Count = std::exchange(rhs.m_Count, 0);
+        m_Hits = std::move(rhs.m_Hits);
+        rhs.m_Hits.clear();
+        m_HitsEnabled = std::exchange(rhs.m_HitsEnabled, false);
+        m_Version = std::max(m_Version, rhs.m_Version) + 1;
+        ++rhs.m_Version;
 
         return *this;
     }
@@ -55,27 +87,43 @@ namespace csys
         return m_Count;
     }
 
+    CSYS_INLINE AutoComplete::Stats AutoComplete::Statistics() const
+    {
+        Stats stats;
+        StatisticsAux(m_Root, 1, 1, stats);
+
+        // Sums to averages.
+        stats.m_Nodes = m_Size;
+        if (stats.m_Words != 0)
+        {
+            stats.m_AverageDepth /= double(stats.m_Words);
+            stats.m_AverageLength /= double(stats.m_Words);
+        }
+        return stats;
+    }
+
     CSYS_INLINE bool AutoComplete::Search(const char *word)
     {
-        ACNode *ptr = m_Root;
+        NodeIndex index = m_Root;
 
         // Traverse tree in look for the given string.
-        while (ptr)
+        while (index != NIL)
         {
-            if (*word < ptr->m_Data)
+            const ACNode &node = m_Nodes[index];
+            if (*word < node.m_Data)
             {
-                ptr = ptr->m_Less;
-            } else if (*word == ptr->m_Data)
+                index = node.m_Less;
+            } else if (*word == node.m_Data)
             {
                 // Word was found.
-                if (*(word + 1) == '\0' && ptr->m_IsWord)
+                if (*(word + 1) == '\0' && node.m_IsWord)
                     return true;
 
-                ptr = ptr->m_Equal;
+                index = node.m_Equal;
                 ++word;
             } else
             {
-                ptr = ptr->m_Greater;
+                index = node.m_Greater;
             }
         }
 
@@ -84,40 +132,50 @@ namespace csys
 
     CSYS_INLINE void AutoComplete::Insert(const char *word)
     {
-        ACNode **ptr = &m_Root;
+        // Words already in the tree leave shared nodes shared.
+        if (FindWord(word) != NIL) return;
+
+        // Links are re-read after every allocation, as the pool may have moved.
+        NodeIndex parent = NIL;
+        NodeIndex ACNode::*link = &ACNode::m_Equal;
+        auto &nodes = m_Nodes.Write();
         ++m_Count;
+        ++m_Version;
 
         while (*word != '\0')
         {
             // Insert char into tree.
-            if (*ptr == nullptr)
+            NodeIndex index = Link(parent, link);
+            if (index == NIL)
             {
-                *ptr = new ACNode(*word);
-                ++m_Size;
+                index = NewNode(*word);
+                Link(parent, link) = index;
             }
 
             // Traverse tree.
-            if (*word < (*ptr)->m_Data)
+            ACNode &node = nodes[index];
+            if (*word < node.m_Data)
             {
-                ptr = &(*ptr)->m_Less;
-            } else if (*word == (*ptr)->m_Data)
+                link = &ACNode::m_Less;
+            } else if (*word == node.m_Data)
             {
                 // String is already in tree, therefore only mark as word.
                 if (*(word + 1) == '\0')
                 {
-                    if ((*ptr)->m_IsWord)
+                    if (node.m_IsWord)
                         --m_Count;
 
-                    (*ptr)->m_IsWord = true;
+                    node.m_IsWord = true;
                 }
 
                 // Advance.
-                ptr = &(*ptr)->m_Equal;
+                link = &ACNode::m_Equal;
                 ++word;
             } else
             {
-                ptr = &(*ptr)->m_Greater;
+                link = &ACNode::m_Greater;
             }
+            parent = index;
         }
     }
 
@@ -128,42 +186,68 @@ namespace csys
 
     CSYS_INLINE void AutoComplete::Remove(const std::string &word)
     {
+        // Words that aren't in the tree leave shared nodes shared.
+        if (FindWord(word) == NIL) return;
+
+        // Root itself is never freed, as nothing links to it but m_Root.
+        ++m_Version;
         RemoveAux(m_Root, word.c_str());
     }
 
+    CSYS_INLINE void AutoComplete::Rebalance()
+    {
+        // Words come out sorted, with their counters.
+        sVector words;
+        words.reserve(m_Count);
+        std::vector<uint32_t> hits;
+        std::string buffer;
+        size_t remaining = SIZE_MAX;
+        auto collect = [this, &words, &hits](std::string_view word)
+        {
+            words.emplace_back(word);
+            if (m_HitsEnabled)
+                hits.push_back(m_Hits.Get(FindWord(word)).m_Word);
+        };
+        VisitAux(m_Nodes.data(), m_Root, buffer, remaining, collect);
+
+        Build(std::move(words), hits);
+    }
+
     CSYS_INLINE void AutoComplete::Suggestions(const char *prefix, std::vector<std::string> &ac_options)
     {
-        ACNode *ptr = m_Root;
+        NodeIndex index = m_Root;
         auto temp = prefix;
 
         // Traverse tree and check if prefix exists.
-        while (ptr)
+        while (index != NIL)
         {
-            if (*prefix < ptr->m_Data)
+            const ACNode &node = m_Nodes[index];
+            if (*prefix < node.m_Data)
             {
-                ptr = ptr->m_Less;
-            } else if (*prefix == ptr->m_Data)
+                index = node.m_Less;
+            } else if (*prefix == node.m_Data)
             {
                 // Prefix exists in tree.
                 if (*(prefix + 1) == '\0')
                     break;
 
-                ptr = ptr->m_Equal;
+                index = node.m_Equal;
                 ++prefix;
             } else
             {
-                ptr = ptr->m_Greater;
+                index = node.m_Greater;
             }
         }
 
-        // Already a word. (No need to auto complete).
-        if (ptr && ptr->m_IsWord) return;
-
         // Prefix is not in tree.
-        if (!ptr) return;
+        if (index == NIL) return;
+
+        // Already a word. (No need to auto complete).
+        if (m_Nodes[index].m_IsWord) return;
 
         // Retrieve auto complete options.
-        SuggestionsAux(ptr->m_Equal, ac_options, temp);
+        std::string buffer(temp);
+        SuggestionsAux(m_Nodes[index].m_Equal, ac_options, buffer);
     }
 
     CSYS_INLINE std::string AutoComplete::Suggestions(const std::string &prefix, r_sVector &ac_options)
@@ -175,56 +259,59 @@ namespace csys
 
     CSYS_INLINE void AutoComplete::Suggestions(std::string &prefix, r_sVector ac_options, bool partial_complete)
     {
-        ACNode *ptr = m_Root;
+        NodeIndex index = m_Root;
         const char *temp = prefix.data();
         size_t prefix_end = prefix.size();
 
         // Traverse tree and check if prefix exists.
-        while (ptr)
+        while (index != NIL)
         {
-            if (*temp < ptr->m_Data)
+            const ACNode &node = m_Nodes[index];
+            if (*temp < node.m_Data)
             {
-                ptr = ptr->m_Less;
-            } else if (*temp == ptr->m_Data)
+                index = node.m_Less;
+            } else if (*temp == node.m_Data)
             {
                 // Prefix exists in tree.
                 if (*(temp + 1) == '\0')
                 {
                     if (partial_complete)
                     {
-                        ACNode *pc_ptr = ptr->m_Equal;
+                        NodeIndex pc_index = node.m_Equal;
 
                         // Get partially completed string.
-                        while (pc_ptr)
+                        while (pc_index != NIL)
                         {
-                            if (pc_ptr->m_Equal && !pc_ptr->m_Less && !pc_ptr->m_Greater)
-                                prefix.push_back(pc_ptr->m_Data);
+                            const ACNode &pc_node = m_Nodes[pc_index];
+                            if (pc_node.m_Equal != NIL && pc_node.m_Less == NIL && pc_node.m_Greater == NIL)
+                                prefix.push_back(pc_node.m_Data);
                             else
                                 break;
 
-                            pc_ptr = pc_ptr->m_Equal;
+                            pc_index = pc_node.m_Equal;
                         }
                     }
 
                     break;
                 }
 
-                ptr = ptr->m_Equal;
+                index = node.m_Equal;
                 ++temp;
             } else
             {
-                ptr = ptr->m_Greater;
+                index = node.m_Greater;
             }
         }
 
-        // Already a word. (No need to auto complete).
-        if (ptr && ptr->m_IsWord) return;
-
         // Prefix is not in tree.
-        if (!ptr) return;
+        if (index == NIL) return;
+
+        // Already a word. (No need to auto complete).
+        if (m_Nodes[index].m_IsWord) return;
 
         // Retrieve auto complete options.
-        SuggestionsAux(ptr->m_Equal, ac_options, prefix.substr(0, prefix_end));
+        std::string buffer = prefix.substr(0, prefix_end);
+        SuggestionsAux(m_Nodes[index].m_Equal, ac_options, buffer);
     }
 
     CSYS_INLINE std::unique_ptr<AutoComplete::sVector> AutoComplete::Suggestions(const char *prefix)
@@ -234,85 +321,692 @@ namespace csys
         return temp;
     }
 
+    CSYS_INLINE size_t AutoComplete::SuggestionCount(std::string_view prefix) const
+    {
+        return CountAux(m_Nodes.data(), prefix.empty() ? m_Root : FindCompletions(m_Nodes.data(), m_Root, prefix));
+    }
+
+    CSYS_INLINE void AutoComplete::FuzzySuggestions(std::string_view query, size_t max_distance, size_t max_results,
+                                                    r_sVector ac_options) const
+    {
+        FuzzySuggestions(m_Nodes.data(), m_Root, query, max_distance, max_results, ac_options);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Private methods ////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 
-    CSYS_INLINE void AutoComplete::SuggestionsAux(AutoComplete::ACNode *root, r_sVector ac_options, std::string buffer)
+    CSYS_INLINE void AutoComplete::FuzzySuggestions(const ACNode *nodes, NodeIndex root, std::string_view query,
+                                                    size_t max_distance, size_t max_results, r_sVector ac_options)
     {
-        if (!root) return;
+        if (max_results == 0) return;
+
+        // Distances from the empty path.
+        FuzzySearch search{query, max_distance, {}, {}, {}};
+        search.m_Rows.resize(query.size() + 1);
+        for (size_t j = 0; j <= query.size(); ++j)
+            search.m_Rows[j] = j;
 
-        // Continue looking in left branch.
-        if (root->m_Less) SuggestionsAux(root->m_Less, ac_options, buffer);
+        FuzzyAux(nodes, root, 0, search);
 
-        // Word was found, push into autocomplete options.
-        if (root->m_IsWord)
+        // Closest, then shortest, then alphabetical.
+        auto &matches = search.m_Matches;
+        auto closer = [](const std::pair<size_t, std::string> &lhs, const std::pair<size_t, std::string> &rhs)
         {
-            ac_options.push_back(buffer.append(1, root->m_Data));
-            buffer.pop_back();
+            if (lhs.first != rhs.first) return lhs.first < rhs.first;
+            if (lhs.second.size() != rhs.second.size()) return lhs.second.size() < rhs.second.size();
+            return lhs.second < rhs.second;
+        };
+        size_t count = std::min(max_results, matches.size());
+        std::partial_sort(matches.begin(), matches.begin() + long(count), matches.end(), closer);
+
+        for (size_t i = 0; i < count; ++i)
+            ac_options.push_back(std::move(matches[i].second));
+    }
+
+    CSYS_INLINE void AutoComplete::FuzzyAux(const ACNode *nodes, NodeIndex root, size_t depth, FuzzySearch &search)
+    {
+        if (root == NIL) return;
+        const ACNode &node = nodes[root];
+
+        // Siblings share the same path.
+        FuzzyAux(nodes, node.m_Less, depth, search);
+
+        // Row of the path extended by this node (Optimal string alignment distance).
+        std::string_view query = search.m_Query;
+        size_t width = query.size() + 1;
+        if (search.m_Rows.size() < (depth + 2) * width)
+            search.m_Rows.resize((depth + 2) * width);
+        const size_t *prev = &search.m_Rows[depth * width];
+        const size_t *prev2 = depth > 0 ? prev - width : nullptr;
+        size_t *row = &search.m_Rows[(depth + 1) * width];
+        char c = node.m_Data;
+        char prev_c = depth > 0 ? search.m_Buffer[depth - 1] : '\0';
+
+        // Only cells within max distance of the diagonal can be, the ones around the band read as out of distance.
+        // Also the best distance a transposition of c with the next character could reach.
+        size_t max = search.m_MaxDistance;
+        size_t i = depth + 1;
+        size_t lo = i > max + 1 ? i - max : 1;
+        size_t hi = std::min(i + max, width - 1);
+        for (size_t j = lo > 2 ? lo - 2 : 1; j < lo; ++j)
+            row[j] = max + 1;
+        if (hi + 1 < width)
+            row[hi + 1] = max + 1;
+
+        row[0] = i;
+        size_t row_min = i;
+        size_t next_min = i;
+        for (size_t j = lo; j <= hi; ++j)
+        {
+            row[j] = std::min({prev[j] + 1, row[j - 1] + 1, prev[j - 1] + (query[j - 1] == c ? 0 : 1)});
+            if (prev2 && j > 1 && c == query[j - 2] && prev_c == query[j - 1])
+                row[j] = std::min(row[j], prev2[j - 2] + 1);
+            if (j > 1 && c == query[j - 1])
+                next_min = std::min(next_min, prev[j - 2] + 1);
+            row_min = std::min(row_min, row[j]);
         }
 
-        // Continue in middle branch, and push character.
-        if (root->m_Equal)
+        // Word within distance.
+        search.m_Buffer.push_back(c);
+        if (node.m_IsWord && hi == width - 1 && row[hi] <= max)
+            search.m_Matches.emplace_back(row[hi], search.m_Buffer);
+
+        // Longer paths can't beat this row, or a transposition from the previous one.
+        if (std::min(row_min, next_min) <= max)
+            FuzzyAux(nodes, node.m_Equal, depth + 1, search);
+        search.m_Buffer.pop_back();
+
+        FuzzyAux(nodes, node.m_Greater, depth, search);
+    }
+
+    CSYS_INLINE void AutoComplete::EnableHits()
+    {
+        m_HitsEnabled = true;
+    }
+
+    CSYS_INLINE bool AutoComplete::HitsEnabled() const
+    {
+        return m_HitsEnabled;
+    }
+
+    CSYS_INLINE bool AutoComplete::Hit(std::string_view word, uint32_t count)
+    {
+        if (word.empty()) return false;
+
+        // Counters are only allocated for words of the tree.
+        if (!m_HitsEnabled)
         {
-            SuggestionsAux(root->m_Equal, ac_options, buffer.append(1, root->m_Data));
-            buffer.pop_back();
+            if (FindWord(word) == NIL) return false;
+            EnableHits();
         }
 
-        // Continue looking in right branch.
-        if (root->m_Greater)
+        // Next node towards the word, NIL once reached.
+        auto next = [this, word](NodeIndex index, size_t &i)
+        {
+            const ACNode &node = m_Nodes[index];
+            if (word[i] < node.m_Data)
+                return node.m_Less;
+            if (word[i] > node.m_Data)
+                return node.m_Greater;
+            return ++i < word.size() ? node.m_Equal : NIL;
+        };
+
+        // Path to the word, the first nodes of longer paths only.
+        constexpr size_t max_path = 64;
+        NodeIndex path[max_path];
+        size_t depth = 0;
+        NodeIndex index = m_Root;
+        size_t i = 0;
+        while (index != NIL)
+        {
+            if (depth < max_path)
+                path[depth] = index;
+            ++depth;
+
+            NodeIndex child = next(index, i);
+            if (i == word.size()) break;
+            index = child;
+        }
+        if (index == NIL || !m_Nodes[index].m_IsWord) return false;
+
+        NodeHits counters = m_Hits.Get(index);
+        uint32_t hits = count > UINT32_MAX - counters.m_Word ? UINT32_MAX : counters.m_Word + count;
+        counters.m_Word = hits;
+        m_Hits.Set(index, counters);
+
+        // Raises the bound of a node, false if it already bounds the word.
+        auto raise = [this, hits](NodeIndex node)
+        {
+            NodeHits bound = m_Hits.Get(node);
+            if (bound.m_Max >= hits) return false;
+            bound.m_Max = hits;
+            m_Hits.Set(node, bound);
+            return true;
+        };
+
+        // Raise bounds bottom up, ancestors of a node that bounds the word already do.
+        if (depth <= max_path)
+        {
+            while (depth-- > 0 && raise(path[depth]));
+            return true;
+        }
+
+        // Top down on paths that didn't fit.
+        i = 0;
+        for (index = m_Root; index != NIL; index = next(index, i))
+            raise(index);
+        return true;
+    }
+
+    CSYS_INLINE uint32_t AutoComplete::Hits(std::string_view word) const
+    {
+        NodeIndex found = m_HitsEnabled ? FindWord(word) : NIL;
+        return found == NIL ? 0 : m_Hits.Get(found).m_Word;
+    }
+
+    CSYS_INLINE void AutoComplete::ClearHits()
+    {
+        m_Hits.clear();
+    }
+
+    CSYS_INLINE void AutoComplete::RankedSuggestions(std::string_view prefix, size_t max_results, r_sVector ac_options) const
+    {
+        // All ties, alphabetical.
+        if (!m_HitsEnabled)
+        {
+            auto collect = [&ac_options](std::string_view word) { ac_options.emplace_back(word); };
+            VisitSuggestions(m_Nodes.data(), m_Root, prefix, max_results, collect);
+            return;
+        }
+
+        NodeIndex root = prefix.empty() ? m_Root : FindCompletions(m_Nodes.data(), m_Root, prefix);
+        if (root == NIL || max_results == 0) return;
+
+        // Best first, subtrees are only opened while they may hold a better word than the ones left.
+        // Entries cover disjoint ranges of words, so ties are taken in alphabetical order of their smallest word.
+        auto later = [](const RankedEntry &lhs, const RankedEntry &rhs)
+        {
+            if (lhs.m_Bound != rhs.m_Bound) return lhs.m_Bound < rhs.m_Bound;
+            if (lhs.m_Key != rhs.m_Key)
+                return std::lexicographical_compare(rhs.m_Key.begin(), rhs.m_Key.end(), lhs.m_Key.begin(), lhs.m_Key.end());
+            return lhs.m_Node != NIL && rhs.m_Node == NIL;
+        };
+        std::vector<RankedEntry> queue;
+        auto push = [&queue, &later](RankedEntry entry)
+        {
+            queue.push_back(std::move(entry));
+            std::push_heap(queue.begin(), queue.end(), later);
+        };
+        push(RankedEntry{m_Hits.Get(root).m_Max, root, prefix.size(), std::string(prefix)});
+
+        size_t found = 0;
+        while (found < max_results && !queue.empty())
+        {
+            std::pop_heap(queue.begin(), queue.end(), later);
+            RankedEntry entry = std::move(queue.back());
+            queue.pop_back();
+
+            // Best word left.
+            if (entry.m_Node == NIL)
+            {
+                ac_options.push_back(std::move(entry.m_Key));
+                ++found;
+                continue;
+            }
+
+            // Split subtree, smaller characters keep the entry's key.
+            const ACNode &node = m_Nodes[entry.m_Node];
+            std::string path = entry.m_Key.substr(0, entry.m_Depth);
+            if (node.m_Less != NIL)
+                push(RankedEntry{m_Hits.Get(node.m_Less).m_Max, node.m_Less, entry.m_Depth, std::move(entry.m_Key)});
+            if (node.m_Greater != NIL)
+                push(RankedEntry{m_Hits.Get(node.m_Greater).m_Max, node.m_Greater, entry.m_Depth,
+                                 path + char(node.m_Data + 1)});
+
+            path.push_back(node.m_Data);
+            if (node.m_IsWord)
+                push(RankedEntry{m_Hits.Get(entry.m_Node).m_Word, NIL, 0, path});
+            if (node.m_Equal != NIL)
+                push(RankedEntry{m_Hits.Get(node.m_Equal).m_Max, node.m_Equal, entry.m_Depth + 1, std::move(path)});
+        }
+    }
+
+    CSYS_INLINE AutoComplete::NodeIndex AutoComplete::FindCompletions(const ACNode *nodes, NodeIndex root,
+                                                                      std::string_view prefix)
+    {
+        NodeIndex index = root;
+        size_t i = 0;
+
+        // Traverse tree and check if prefix exists.
+        while (index != NIL)
+        {
+            const ACNode &node = nodes[index];
+            if (prefix[i] < node.m_Data)
+            {
+                index = node.m_Less;
+            } else if (prefix[i] == node.m_Data)
+            {
+                // Prefix exists in tree, no completions if it's already a word.
+                if (++i == prefix.size())
+                    return node.m_IsWord ? NIL : node.m_Equal;
+
+                index = node.m_Equal;
+            } else
+            {
+                index = node.m_Greater;
+            }
+        }
+
+        return NIL;
+    }
+
+    CSYS_INLINE size_t AutoComplete::CountAux(const ACNode *nodes, NodeIndex root)
+    {
+        if (root == NIL) return 0;
+        const ACNode &node = nodes[root];
+
+        return size_t(node.m_IsWord) + CountAux(nodes, node.m_Less) + CountAux(nodes, node.m_Equal) +
+               CountAux(nodes, node.m_Greater);
+    }
+
+    CSYS_INLINE void AutoComplete::Build(sVector words, const std::vector<uint32_t> &hits)
+    {
+        // Sorted counters are given for sorted unique words only.
+        if (hits.empty())
+        {
+            std::sort(words.begin(), words.end());
+            words.erase(std::unique(words.begin(), words.end()), words.end());
+            if (!words.empty() && words.front().empty())
+                words.erase(words.begin());
+        }
+
+        // Start over, counters are still kept if they were.
+        m_Nodes = SharedVector<ACNode>(std::vector<ACNode>(1, ACNode('\0')));
+        m_Hits.clear();
+        m_FreeList = NIL;
+        m_Size = 0;
+        m_Count = words.size();
+        ++m_Version;
+
+        m_Root = BuildAux(words, hits, 0, words.size(), 0);
+    }
+
+    CSYS_INLINE AutoComplete::NodeIndex AutoComplete::BuildAux(const sVector &words, const std::vector<uint32_t> &hits,
+                                                                size_t begin, size_t end, size_t depth)
+    {
+        if (begin == end) return NIL;
+
+        // Words sharing the middle word's character are contiguous, the shortest one may end here.
+        char data = words[begin + (end - begin) / 2][depth];
+        auto first = std::partition_point(words.begin() + long(begin), words.begin() + long(end),
+                                          [depth, data](const std::string &word) { return word[depth] < data; });
+        auto last = std::partition_point(first, words.begin() + long(end),
+                                         [depth, data](const std::string &word) { return word[depth] == data; });
+        size_t equal = size_t(first - words.begin()), greater = size_t(last - words.begin());
+        bool is_word = words[equal].size() == depth + 1;
+
+        // Children are built after the node, the pool may move in between.
+        NodeIndex index = NewNode(data);
+        NodeIndex less_child = BuildAux(words, hits, begin, equal, depth);
+        NodeIndex equal_child = BuildAux(words, hits, equal + size_t(is_word), greater, depth + 1);
+        NodeIndex greater_child = BuildAux(words, hits, greater, end, depth);
+
+        ACNode &node = m_Nodes.Write()[index];
+        node.m_IsWord = is_word;
+        node.m_Less = less_child;
+        node.m_Equal = equal_child;
+        node.m_Greater = greater_child;
+        if (m_HitsEnabled)
+        {
+            m_Hits.Set(index, NodeHits{is_word && !hits.empty() ? hits[equal] : 0, 0});
+            RefreshHits(index);
+        }
+
+        return index;
+    }
+
+    CSYS_INLINE void AutoComplete::StatisticsAux(NodeIndex root, size_t depth, size_t length, Stats &stats) const
+    {
+        if (root == NIL) return;
+        const ACNode &node = m_Nodes[root];
+
+        if (node.m_IsWord)
         {
-            SuggestionsAux(root->m_Greater, ac_options, buffer);
+            ++stats.m_Words;
+            stats.m_MaxDepth = std::max(stats.m_MaxDepth, depth);
+            stats.m_AverageDepth += double(depth);
+            stats.m_AverageLength += double(length);
         }
+
+        StatisticsAux(node.m_Less, depth + 1, length, stats);
+        StatisticsAux(node.m_Equal, depth + 1, length + 1, stats);
+        StatisticsAux(node.m_Greater, depth + 1, length, stats);
     }
 
-    CSYS_INLINE bool AutoComplete::RemoveAux(AutoComplete::ACNode *root, const char *word)
+    CSYS_INLINE void AutoComplete::SuggestionsAux(NodeIndex root, r_sVector ac_options, std::string &buffer)
     {
-        if (!root) return false;
+        // Collect every word.
+        size_t remaining = SIZE_MAX;
+        auto collect = [&ac_options](std::string_view word) { ac_options.emplace_back(word); };
+        VisitAux(m_Nodes.data(), root, buffer, remaining, collect);
+    }
+
+    CSYS_INLINE bool AutoComplete::RemoveAux(NodeIndex root, const char *word)
+    {
+        if (root == NIL) return false;
+        ACNode &node = m_Nodes.Write()[root];
 
         // String is in TST.
-        if (*(word + 1) == '\0' && root->m_Data == *word)
+        if (*(word + 1) == '\0' && node.m_Data == *word)
         {
             // Un-mark word node.
-            if (root->m_IsWord)
+            if (node.m_IsWord)
             {
-                root->m_IsWord = false;
-                return (!root->m_Equal && !root->m_Less && !root->m_Greater);
+                node.m_IsWord = false;
+                --m_Count;
+                if (m_HitsEnabled)
+                {
+                    m_Hits.Set(root, NodeHits{0, m_Hits.Get(root).m_Max});
+                    RefreshHits(root);
+                }
+                return (node.m_Equal == NIL && node.m_Less == NIL && node.m_Greater == NIL);
             }
                 // String is a prefix.
             else
                 return false;
         } else
         {
-            // String is a prefix.
-            if (*word < root->m_Data)
-                RemoveAux(root->m_Less, word);
-            else if (*word > root->m_Data)
-                RemoveAux(root->m_Greater, word);
-
-                // String is in TST.
-            else if (*word == root->m_Data)
+            // Follow the word, the link to prune if the child ends up unused.
+            NodeIndex ACNode::*link = &ACNode::m_Equal;
+            if (*word < node.m_Data)
+                link = &ACNode::m_Less;
+            else if (*word > node.m_Data)
+                link = &ACNode::m_Greater;
+
+            // Child is unused.
+            bool unused = RemoveAux(node.*link, link == &ACNode::m_Equal ? word + 1 : word);
+            if (unused)
             {
-                // Char is unique.
-                if (RemoveAux(root->m_Equal, word + 1))
-                {
-                    delete root->m_Equal;
-                    root->m_Equal = nullptr;
-                    return !root->m_IsWord && (!root->m_Equal && !root->m_Less && !root->m_Greater);
-                }
+                FreeNode(node.*link);
+                node.*link = NIL;
             }
+            RefreshHits(root);
+            if (unused)
+                return !node.m_IsWord && (node.m_Equal == NIL && node.m_Less == NIL && node.m_Greater == NIL);
         }
 
         return false;
     }
 
-    CSYS_INLINE void AutoComplete::DeepClone(AutoComplete::ACNode *src, AutoComplete::ACNode *&dest)
+    CSYS_INLINE AutoComplete::NodeIndex AutoComplete::FindWord(std::string_view word) const
+    {
+        if (word.empty()) return NIL;
+        NodeIndex index = m_Root;
+        size_t i = 0;
+
+        // Traverse tree in look for the given string.
+        while (index != NIL)
+        {
+            const ACNode &node = m_Nodes[index];
+            if (word[i] < node.m_Data)
+            {
+                index = node.m_Less;
+            } else if (word[i] == node.m_Data)
+            {
+                // Word was found.
+                if (++i == word.size())
+                    return node.m_IsWord ? index : NIL;
+
+                index = node.m_Equal;
+            } else
+            {
+                index = node.m_Greater;
+            }
+        }
+
+        return NIL;
+    }
+
+    CSYS_INLINE void AutoComplete::RefreshHits(NodeIndex index)
+    {
+        if (!m_HitsEnabled) return;
+        const ACNode &node = m_Nodes[index];
+
+        NodeHits hits = m_Hits.Get(index);
+        hits.m_Max = std::max({hits.m_Word, m_Hits.Get(node.m_Less).m_Max, m_Hits.Get(node.m_Equal).m_Max,
+                               m_Hits.Get(node.m_Greater).m_Max});
+        m_Hits.Set(index, hits);
+    }
+
+    CSYS_INLINE AutoComplete::NodeIndex AutoComplete::NewNode(char data)
+    {
+        ++m_Size;
+        auto &nodes = m_Nodes.Write();
+
+        // Reuse a freed node.
+        if (m_FreeList != NIL)
+        {
+            NodeIndex index = m_FreeList;
+            m_FreeList = nodes[index].m_Equal;
+            nodes[index] = ACNode(data);
+            if (m_HitsEnabled)
+                m_Hits.Set(index, NodeHits());
+            return index;
+        }
+
+        // Moved from trees have no reserved slot.
+        if (nodes.empty())
+            nodes.emplace_back('\0');
+
+        nodes.emplace_back(data);
+        return NodeIndex(nodes.size() - 1);
+    }
+
+    CSYS_INLINE void AutoComplete::FreeNode(NodeIndex index)
+    {
+        --m_Size;
+        if (m_HitsEnabled)
+            m_Hits.Set(index, NodeHits());
+        m_Nodes.Write()[index].m_Equal = m_FreeList;
+        m_FreeList = index;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Hit table //////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE AutoComplete::NodeHits AutoComplete::HitTable::Get(NodeIndex index) const
+    {
+        if (m_Slots.empty()) return NodeHits();
+
+        // Free slots hold zero counters.
+        return m_Slots[Probe(index)].m_Hits;
+    }
+
+    CSYS_INLINE void AutoComplete::HitTable::Set(NodeIndex index, const NodeHits &hits)
+    {
+        bool zero = hits.m_Word == 0 && hits.m_Max == 0;
+        if (m_Slots.empty())
+        {
+            if (zero) return;
+            Reserve(s_HitReserve);
+        }
+
+        // Shared slots are only copied once something changes.
+        size_t position = Probe(index);
+        if (m_Slots[position].m_Node == NIL)
+        {
+            if (zero) return;
+
+            // Kept at most half full.
+            if ((m_Used + 1) * 2 > m_Slots.size())
+            {
+                Reserve(m_Used + 1);
+                position = Probe(index);
+            }
+            m_Slots.Write()[position].m_Node = index;
+            ++m_Used;
+        }
+        else if (m_Slots[position].m_Hits.m_Word == hits.m_Word && m_Slots[position].m_Hits.m_Max == hits.m_Max)
+            return;
+
+        m_Slots.Write()[position].m_Hits = hits;
+    }
+
+    CSYS_INLINE void AutoComplete::HitTable::Reserve(size_t count)
+    {
+        size_t size = 8;
+        while (size < count * 2)
+            size *= 2;
+        if (size <= m_Slots.size()) return;
+
+        // Rehash into a bigger table of this tree only.
+        std::vector<Slot> slots(size);
+        for (size_t i = 0; i < m_Slots.size(); ++i)
+        {
+            const Slot &slot = m_Slots[i];
+            if (slot.m_Node == NIL) continue;
+
+            size_t position = slot.m_Node & (size - 1);
+            while (slots[position].m_Node != NIL)
+                position = (position + 1) & (size - 1);
+            slots[position] = slot;
+        }
+        m_Slots = SharedVector<Slot>(std::move(slots));
+    }
+
+    CSYS_INLINE void AutoComplete::HitTable::clear()
+    {
+        m_Slots.clear();
+        m_Used = 0;
+    }
+
+    CSYS_INLINE size_t AutoComplete::HitTable::Probe(NodeIndex index) const
+    {
+        size_t mask = m_Slots.size() - 1;
+        // Nodes of a path are close in the pool, keeping them close in the table.
+        size_t position = index & mask;
+        while (m_Slots[position].m_Node != index && m_Slots[position].m_Node != NIL)
+            position = (position + 1) & mask;
+        return position;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Cursor /////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE AutoComplete::Cursor::Cursor(const AutoComplete &tree) : m_Tree(&tree), m_Version(tree.m_Version)
+    {
+    }
+
+    CSYS_INLINE bool AutoComplete::Cursor::Push(char c)
+    {
+        Sync();
+        m_Prefix.push_back(c);
+        m_Path.push_back(Step(m_Path.size()));
+        return m_Path.back() != NIL;
+    }
+
+    CSYS_INLINE bool AutoComplete::Cursor::Pop()
+    {
+        if (m_Prefix.empty()) return false;
+
+        // Nodes of the remaining characters are checked on next use.
+        m_Prefix.pop_back();
+        m_Path.pop_back();
+        return true;
+    }
+
+    CSYS_INLINE void AutoComplete::Cursor::Clear()
+    {
+        m_Prefix.clear();
+        m_Path.clear();
+    }
+
+    CSYS_INLINE const std::string &AutoComplete::Cursor::Prefix() const
+    {
+        return m_Prefix;
+    }
+
+    CSYS_INLINE bool AutoComplete::Cursor::Valid() const
+    {
+        return m_Version == m_Tree->m_Version;
+    }
+
+    CSYS_INLINE bool AutoComplete::Cursor::Matches()
+    {
+        Sync();
+        return m_Path.empty() || m_Path.back() != NIL;
+    }
+
+    CSYS_INLINE bool AutoComplete::Cursor::IsWord()
+    {
+        Sync();
+        return !m_Path.empty() && m_Path.back() != NIL && m_Tree->m_Nodes[m_Path.back()].m_IsWord;
+    }
+
+    CSYS_INLINE size_t AutoComplete::Cursor::Complete()
+    {
+        Sync();
+        if (m_Path.empty() || m_Path.back() == NIL) return 0;
+
+        // Follow nodes without siblings, leaving the last character of a single completion to be typed.
+        const auto &nodes = m_Tree->m_Nodes;
+        size_t pushed = 0;
+        for (NodeIndex index = nodes[m_Path.back()].m_Equal; index != NIL; index = nodes[index].m_Equal)
+        {
+            const ACNode &node = nodes[index];
+            if (node.m_Equal == NIL || node.m_Less != NIL || node.m_Greater != NIL)
+                break;
+
+            m_Prefix.push_back(node.m_Data);
+            m_Path.push_back(index);
+            ++pushed;
+        }
+
+        return pushed;
+    }
+
+    CSYS_INLINE void AutoComplete::Cursor::Suggestions(r_sVector ac_options)
+    {
+        auto collect = [&ac_options](std::string_view word) { ac_options.emplace_back(word); };
+        Suggestions(SIZE_MAX, collect);
+    }
+
+    CSYS_INLINE size_t AutoComplete::Cursor::SuggestionCount()
+    {
+        return CountAux(m_Tree->m_Nodes.data(), Completions());
+    }
+
+    CSYS_INLINE void AutoComplete::Cursor::Sync()
+    {
+        if (Valid()) return;
+
+        // Match the whole prefix again.
+        m_Version = m_Tree->m_Version;
+        for (size_t i = 0; i < m_Prefix.size(); ++i)
+            m_Path[i] = Step(i);
+    }
+
+    CSYS_INLINE AutoComplete::NodeIndex AutoComplete::Cursor::Step(size_t i) const
+    {
+        // First character is searched from the root, the others below the previous match.
+        const auto &nodes = m_Tree->m_Nodes;
+        NodeIndex index = i == 0 ? m_Tree->m_Root : m_Path[i - 1] == NIL ? NIL : nodes[m_Path[i - 1]].m_Equal;
+        char c = m_Prefix[i];
+        while (index != NIL && nodes[index].m_Data != c)
+            index = c < nodes[index].m_Data ? nodes[index].m_Less : nodes[index].m_Greater;
+
+        return index;
+    }
+
+    CSYS_INLINE AutoComplete::NodeIndex AutoComplete::Cursor::Completions()
     {
-        if (!src) return;
+        Sync();
+        if (m_Path.empty()) return m_Tree->m_Root;
 
-        dest = new ACNode(*src);
-        DeepClone(src->m_Less, dest->m_Less);
-        DeepClone(src->m_Equal, dest->m_Equal);
-        DeepClone(src->m_Greater, dest->m_Greater);
+        NodeIndex last = m_Path.back();
+        return last == NIL || m_Tree->m_Nodes[last].m_IsWord ? NIL : m_Tree->m_Nodes[last].m_Equal;
     }
 }
@@ -5,7 +5,9 @@
 #define CSYS_COMMAND_H
 #pragma once
 
-#include <functional>
+#include <memory>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include "csys/arguments.h"
@@ -14,10 +16,68 @@
 
 namespace csys
 {
+    /*!
+     * \brief
+     *      Type-erased storage for arguments that were already parsed by a command, used to invoke it later without
+     *      parsing the command line again
+     */
+    struct ArgumentPack
+    {
+        /*!
+         * \brief
+         *      Default virtual destructor
+         */
+        virtual ~ArgumentPack() = default;
+    };
+
+    /*!
+     * \brief
+     *      Tag to register a command whose function runs on the system thread pool (See System::RegisterCommand)
+     */
+    struct Async
+    {
+    };
+
+    /*!
+     * \brief
+     *      Invokes a command function and turns its result into the command output
+     * \tparam Result
+     *      Return type of the function. Only a returned csys::Item is kept as output
+     * \param name
+     *      Name of the command, prefixes the error of a csys::Exception thrown by the function
+     * \param function
+     *      Function to invoke
+     * \param values
+     *      Arguments of the function
+     * \return
+     *      Item returned by the function, item error if it threw a csys::Exception, or item none
+     */
+    template<typename Result, typename Function, typename ...Values>
+    Item InvokeCommand(const String &name, Function &function, Values &&... values)
+    {
+        CSYS_TRY
+        {
+            if constexpr (std::is_same_v<Result, Item>)
+                return function(std::forward<Values>(values)...);
+            else
+            {
+                function(std::forward<Values>(values)...);
+                return Item(NONE);
+            }
+        }
+        CSYS_CATCH(const Exception &e)
+        {
+            // Error raised by the function
+            return Item(ERROR) << (name.m_String + ": " + e.what());
+        }
+    }
+
     /*!
      * \brief
      *      Non-templated class that allows for the storage of commands as well as accessing certain functionality of
-     *      said commands.
+     *      said commands. Parsed arguments are per call, so a command holds no parse state. The function itself is
+     *      called through a non-const reference (Mutable lambdas are allowed), it must be thread safe for the command
+     *      to run from several threads at once
      */
     struct CommandBase
     {
@@ -33,9 +93,32 @@ namespace csys
          * \param input
          *      String of arguments for the command to parse and pass to the function
          * \return
+         *      Returns item error if the parsing in someway was messed up or the function threw a csys::Exception,
+         *      otherwise the item returned by the function or none
+         */
+        virtual Item operator()(std::string_view input) const = 0;
+
+        /*!
+         * \brief
+         *      Parses the arguments of the command without running it
+         * \param input
+         *      String of arguments for the command to parse
+         * \param[out] pack
+         *      Parsed arguments, only set if parsing succeeded
+         * \return
          *      Returns item error if the parsing in someway was messed up, and none if there was no issue
          */
-        virtual Item operator()(String &input) = 0;
+        virtual Item Compile(std::string_view input, std::unique_ptr<ArgumentPack> &pack) const = 0;
+
+        /*!
+         * \brief
+         *      Runs the function held within the child class with arguments previously parsed by Compile
+         * \param pack
+         *      Arguments returned by Compile on this same command
+         * \return
+         *      Returns item returned by the function, item error if it threw a csys::Exception, or item none
+         */
+        virtual Item Run(const ArgumentPack &pack) const = 0;
 
         /*!
          * \brief
@@ -43,7 +126,7 @@ namespace csys
          * \return
          *      String containing info about the command
          */
-        [[nodiscard]] virtual std::string Help() = 0;
+        [[nodiscard]] virtual std::string Help() const = 0;
 
         /*!
          * \brief
@@ -53,6 +136,16 @@ namespace csys
          */
         [[nodiscard]] virtual size_t ArgumentCount() const = 0;
 
+        /*!
+         * \brief
+         *      Checks if an argument of the command is a boolean
+         * \param index
+         *      Position of the argument
+         * \return
+         *      Returns false if the argument isn't a boolean or the command takes fewer arguments
+         */
+        [[nodiscard]] virtual bool BoolArgument(size_t index) const = 0;
+
         /*!
          * \brief
          *      Deep copies a command
@@ -60,6 +153,8 @@ namespace csys
          *      Pointer to newly copied command
          */
         [[nodiscard]] virtual CommandBase* Clone() const = 0;
+
+        bool m_Async = false;    //!< Flag to determine if the function runs on the system thread pool
     };
 
     /*!
@@ -76,8 +171,7 @@ namespace csys
     public:
         /*!
          * \brief
-         *      Constructor that sets the name, description, function and arguments as well as add a null argument
-         *      for parsing
+         *      Constructor that sets the name, description, function and arguments
          * \param name
          *      Name of the command to call by
          * \param description
@@ -89,8 +183,8 @@ namespace csys
          */
         Command(String name, String description, Fn function, Args... args) : m_Name(std::move(name)),
                                                                               m_Description(std::move(description)),
-                                                                              m_Function(function),
-                                                                              m_Arguments(args..., Arg<NULL_ARGUMENT>())
+                                                                              m_Function(std::move(function)),
+                                                                              m_Arguments(args...)
         {}
 
         /*!
@@ -99,31 +193,64 @@ namespace csys
          * \param input
          *      String of arguments for the command to parse and pass to the function
          * \return
+         *      Returns item error if the parsing in someway was messed up or the function threw a csys::Exception,
+         *      otherwise the item returned by the function or none
+         */
+        Item operator()(std::string_view input) const final
+        {
+            // Parse into values local to this call
+            Values values;
+            if (auto error = Parse(input, values))
+                return Item(ERROR) << (m_Name.m_String + ": " + error.Message(input));
+
+            // Call function with unpacked tuple, values are not used after the call
+            return std::apply([this](auto &... value)
+                              { return InvokeCommand<Result>(m_Name, m_Function, std::move(value)...); }, values);
+        }
+
+        /*!
+         * \brief
+         *      Parses the arguments and stores their values in a pack
+         * \param input
+         *      String of arguments for the command to parse
+         * \param[out] pack
+         *      Parsed arguments, only set if parsing succeeded
+         * \return
          *      Returns item error if the parsing in someway was messed up, and none if there was no issue
          */
-        Item operator()(String &input) final
+        Item Compile(std::string_view input, std::unique_ptr<ArgumentPack> &pack) const final
         {
-            try
-            {
-                // Try to parse and call the function
-                constexpr int argumentSize = sizeof... (Args);
-                Call(input, std::make_index_sequence<argumentSize + 1>{}, std::make_index_sequence<argumentSize>{});
-            }
-            catch (Exception &ae)
-            {
-                // Error happened with parsing
-                return Item(ERROR) << (m_Name.m_String + ": " + ae.what());
-            }
+            // Try to parse
+            Values values;
+            if (auto error = Parse(input, values))
+                return Item(ERROR) << (m_Name.m_String + ": " + error.Message(input));
+
+            pack = std::make_unique<Pack>(std::move(values));
             return Item(NONE);
         }
 
+        /*!
+         * \brief
+         *      Runs the function m_Function with arguments previously parsed by Compile
+         * \param pack
+         *      Arguments returned by Compile on this same command
+         * \return
+         *      Returns item returned by the function, item error if it threw a csys::Exception, or item none
+         */
+        Item Run(const ArgumentPack &pack) const final
+        {
+            return std::apply([this](const auto &... values)
+                              { return InvokeCommand<Result>(m_Name, m_Function, values...); },
+                              static_cast<const Pack &>(pack).m_Values);
+        }
+
         /*!
          * \brief
          *      Gets info about the command and usage
          * \return
          *      String containing info about the command
          */
-        [[nodiscard]] std::string Help() final
+        [[nodiscard]] std::string Help() const final
         {
             return m_Name.m_String + DisplayArguments(std::make_index_sequence<sizeof ...(Args)>{}) + "\n\t\t- " +
                    m_Description.m_String + "\n\n";
@@ -140,6 +267,20 @@ namespace csys
             return sizeof... (Args);
         }
 
+        /*!
+         * \brief
+         *      Checks if an argument of the command is a boolean
+         * \param index
+         *      Position of the argument
+         * \return
+         *      Returns false if the argument isn't a boolean or the command takes fewer arguments
+         */
+        [[nodiscard]] bool BoolArgument(size_t index) const final
+        {
+            size_t i = 0;
+            return ((i++ == index && std::is_same_v<typename Args::ValueType, bool>) || ...);
+        }
+
         /*!
          * \brief
          *      Deep copies a command
@@ -151,47 +292,63 @@ namespace csys
             return new Command<Fn, Args...>(*this);
         }
     private:
+        using Values = std::tuple<typename Args::ValueType...>;    //!< Parsed values of a call
+
+        /*!
+         * \brief
+         *      Parsed argument values of this command
+         */
+        struct Pack : ArgumentPack
+        {
+            explicit Pack(Values values) : m_Values(std::move(values))
+            {}
+
+            Values m_Values;    //!< Parsed values
+        };
+
         /*!
          * \brief
-         *      Parses arguments and passes them into the command to be ran
-         * \tparam Is_p
-         *      Index sequence from 0 to Argument Count + 1, used for parsing
-         * \tparam Is_c
-         *      Index sequence from 0 to Argument Count, used for passing into the function
+         *      Parses arguments
          * \param input
          *      String of arguments to be parsed
+         * \param[out] values
+         *      Parsed values, partially set on failure
+         * \return
+         *      First parse error, empty if every argument was parsed
          */
-        template<size_t... Is_p, size_t... Is_c>
-        void Call(String &input, const std::index_sequence<Is_p...> &, const std::index_sequence<Is_c...> &)
+        static ParseError Parse(std::string_view input, Values &values)
         {
-            size_t start = 0;
+            ArgumentTokens tokens(input);
+            ParseError error;
 
-            // Parse arguments
-            int _[]{0, (void(std::get<Is_p>(m_Arguments).Parse(input, start)), 0)...};
-            (void) (_);
-
-            // Call function with unpacked tuple
-            m_Function((std::get<Is_c>(m_Arguments).m_Arg.m_Value)...);
+            // Split once, then stop at the first argument that fails
+            std::apply([&](auto &... value)
+                       { (void) ((error = Args::TryParseValue(input, tokens, value)) || ...); }, values);
+            if (error)
+                return error;
+            return Arg<NULL_ARGUMENT>().TryParse(input, tokens);
         }
 
         /*!
          * \brief
          *      Displays the usage for running the command successfully
          * \tparam Is
-         *      Index sequence from 0 to Argument CountH
+         *      Index sequence from 0 to Argument Count
          * \return
          *      Returns a string containing the usage of the command
          */
         template<size_t ...Is>
-        std::string DisplayArguments(const std::index_sequence<Is...> &)
+        std::string DisplayArguments(const std::index_sequence<Is...> &) const
         {
             return (std::get<Is>(m_Arguments).Info() + ...);
         }
 
-        const String m_Name;                                            //!< Name of command
-        const String m_Description;                                     //!< Description of the command
-        std::function<void(typename Args::ValueType...)> m_Function;    //!< Function to be invoked as command
-        std::tuple<Args..., Arg<NULL_ARGUMENT>> m_Arguments;            //!< Arguments to be passed into m_Function
+        using Result = std::invoke_result_t<Fn &, typename Args::ValueType...>;    //!< Return type of the function
+
+        const String m_Name;                        //!< Name of command
+        const String m_Description;                 //!< Description of the command
+        mutable Fn m_Function;                      //!< Function to be invoked as command (Calls aren't synchronized, see CommandBase)
+        const std::tuple<Args...> m_Arguments;      //!< Names and types of the arguments of m_Function
     };
 
     /*!
@@ -206,8 +363,7 @@ namespace csys
     public:
         /*!
          * \brief
-         *      Constructor that sets the name, description and function. A null argument will be added to the arguments
-         *      for parsing
+         *      Constructor that sets the name, description and function
          * \param name
          *      Name of the command to call by
          * \param description
@@ -217,7 +373,7 @@ namespace csys
          */
         Command(String name, String description, Fn function) : m_Name(std::move(name)),
                                                                 m_Description(std::move(description)),
-                                                                m_Function(function), m_Arguments(Arg<NULL_ARGUMENT>())
+                                                                m_Function(std::move(function))
         {}
 
         /*!
@@ -226,35 +382,59 @@ namespace csys
          * \param input
          *      String of arguments for the command to parse and pass to the function. This should be empty
          * \return
-         *      Returns item error if the parsing in someway was messed up, and none if there was no issue
+         *      Returns item error if the parsing in someway was messed up or the function threw a csys::Exception,
+         *      otherwise the item returned by the function or none
          */
-        Item operator()(String &input) final
+        Item operator()(std::string_view input) const final
         {
-            // call the function
+            // Check to see if input is all whitespace
             size_t start = 0;
-            try
-            {
-                // Check to see if input is all whitespace
-                std::get<0>(m_Arguments).Parse(input, start);
-            }
-            catch (Exception &ae)
-            {
-                // Command had something passed into it
-                return Item(ERROR) << (m_Name.m_String + ": " + ae.what());
-            }
+            if (auto error = Arg<NULL_ARGUMENT>().TryParse(input, start))
+                return Item(ERROR) << (m_Name.m_String + ": " + error.Message(input));
 
             // Call function
-            m_Function();
+            return InvokeCommand<Result>(m_Name, m_Function);
+        }
+
+        /*!
+         * \brief
+         *      Checks that no arguments were given
+         * \param input
+         *      String of arguments for the command to parse. This should be empty
+         * \param[out] pack
+         *      Empty pack, only set if parsing succeeded
+         * \return
+         *      Returns item error if the parsing in someway was messed up, and none if there was no issue
+         */
+        Item Compile(std::string_view input, std::unique_ptr<ArgumentPack> &pack) const final
+        {
+            // Check to see if input is all whitespace
+            size_t start = 0;
+            if (auto error = Arg<NULL_ARGUMENT>().TryParse(input, start))
+                return Item(ERROR) << (m_Name.m_String + ": " + error.Message(input));
+
+            pack = std::make_unique<ArgumentPack>();
             return Item(NONE);
         }
 
+        /*!
+         * \brief
+         *      Runs the function m_Function
+         * \return
+         *      Returns item returned by the function, item error if it threw a csys::Exception, or item none
+         */
+        Item Run(const ArgumentPack &) const final
+        {
+            return InvokeCommand<Result>(m_Name, m_Function);
+        }
+
         /*!
          * \brief
          *      Gets info about the command and usage
          * \return
          *      String containing info about the command
          */
-        [[nodiscard]] std::string Help() final
+        [[nodiscard]] std::string Help() const final
         {
             return m_Name.m_String + "\n\t\t- " + m_Description.m_String + "\n\n";
         }
@@ -270,6 +450,17 @@ namespace csys
             return 0;
         }
 
+        /*!
+         * \brief
+         *      Checks if an argument of the command is a boolean
+         * \return
+         *      false, there are no arguments
+         */
+        [[nodiscard]] bool BoolArgument(size_t) const final
+        {
+            return false;
+        }
+
         /*!
          * \brief
          *      Deep copies a command
@@ -282,10 +473,11 @@ namespace csys
         }
     private:
 
+        using Result = std::invoke_result_t<Fn &>;     //!< Return type of the function
+
         const String m_Name;                           //!< Name of command
         const String m_Description;                    //!< Description of the command
-        std::function<void(void)> m_Function;          //!< Function to be invoked as command
-        std::tuple<Arg<NULL_ARGUMENT>> m_Arguments;    //!< Arguments to be passed into m_Function
+        mutable Fn m_Function;                         //!< Function to be invoked as command (Calls aren't synchronized, see CommandBase)
     };
 }
 
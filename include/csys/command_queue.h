@@ -0,0 +1,118 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_COMMAND_QUEUE_H
+#define CSYS_COMMAND_QUEUE_H
+#pragma once
+
+#include "csys/api.h"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Bounded multi-producer single-consumer queue of command lines. Lines are copied into fixed size slots, so
+     *      pushing never allocates. Slots are claimed with the sequence number scheme of Dmitry Vyukov's bounded
+     *      queue: a producer only contends with other producers on the tail counter, and never blocks on the consumer.
+     *
+     * \note
+     *      Push can be called from any thread. Pop must only be called from a single (owning) thread.
+     */
+    class CSYS_API CommandQueue
+    {
+    public:
+
+        /*!
+         * \brief
+         *      Constructor
+         * \param capacity
+         *      Number of slots, rounded up to a power of two
+         * \param max_line
+         *      Size in bytes of the biggest line that can be queued
+         */
+        CommandQueue(size_t capacity, size_t max_line);
+
+        CommandQueue(const CommandQueue &) = delete;
+        CommandQueue &operator=(const CommandQueue &) = delete;
+
+        /*!
+         * \brief
+         *      Copy a line into the queue
+         * \param line
+         *      Command line
+         * \return
+         *      False if the queue is full or the line is longer than the slot size
+         */
+        bool Push(std::string_view line);
+
+        /*!
+         * \brief
+         *      Run the oldest queued line and release its slot
+         * \param fn
+         *      Callable of signature void(std::string_view), the line is only valid until the next Pop
+         * \return
+         *      False if the queue is empty
+         * \note
+         *      The line is copied out and its slot released before fn runs, so fn may push lines or destroy the queue
+         */
+        template<typename Fn>
+        bool Pop(Fn &&fn)
+        {
+            Slot &slot = m_Slots[m_Head & m_Mask];
+            if (slot.m_Sequence.load(std::memory_order_acquire) != m_Head + 1)
+                return false;
+
+            // Take the line before releasing the slot to producers.
+            std::string_view line(m_Line.get(), slot.m_Size);
+            if (slot.m_Size != 0) std::memcpy(m_Line.get(), slot.m_Data, slot.m_Size);
+            slot.m_Sequence.store(m_Head + m_Mask + 1, std::memory_order_release);
+            ++m_Head;
+
+            fn(line);
+            return true;
+        }
+
+        /*!
+         * \return
+         *      Number of slots
+         */
+        [[nodiscard]] size_t Capacity() const;
+
+        /*!
+         * \return
+         *      Size in bytes of the biggest line that can be queued
+         */
+        [[nodiscard]] size_t MaxLine() const;
+
+    protected:
+
+        //!< Queue slot.
+        struct Slot
+        {
+            std::atomic<size_t> m_Sequence{0};    //!< Position slot can be pushed at, or position + 1 once filled
+            size_t m_Size = 0;                    //!< Line size
+            char *m_Data = nullptr;               //!< Line storage (Points into m_Buffer)
+        };
+
+        static constexpr size_t s_CacheLine = 64;    //!< Counters are kept on their own cache line
+
+        std::unique_ptr<Slot[]> m_Slots;                    //!< Queue slots
+        std::unique_ptr<char[]> m_Buffer;                   //!< Line storage of every slot
+        std::unique_ptr<char[]> m_Line;                     //!< Line being popped (Consumer only)
+        size_t m_Mask;                                      //!< Slot count - 1
+        size_t m_MaxLine;                                   //!< Slot line size
+        alignas(s_CacheLine) std::atomic<size_t> m_Tail;    //!< Next push position (Shared by producers)
+        alignas(s_CacheLine) size_t m_Head;                 //!< Next pop position (Consumer only)
+    };
+}
+
+#ifdef CSYS_HEADER_ONLY
+#include "csys/command_queue.inl"
+#endif
+
+#endif //CSYS_COMMAND_QUEUE_H
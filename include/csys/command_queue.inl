@@ -0,0 +1,81 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#ifndef CSYS_HEADER_ONLY
+
+#include "csys/command_queue.h"
+
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+namespace csys
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Public methods /////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE CommandQueue::CommandQueue(size_t capacity, size_t max_line) : m_MaxLine(max_line), m_Tail(0), m_Head(0)
+    {
+        // Round up to a power of two, so positions wrap with a mask.
+        size_t slot_count = 2;
+        while (slot_count < capacity) slot_count <<= 1;
+        m_Mask = slot_count - 1;
+
+        m_Slots = std::make_unique<Slot[]>(slot_count);
+        m_Buffer = std::make_unique<char[]>(slot_count * max_line);
+        m_Line = std::make_unique<char[]>(max_line);
+        for (size_t i = 0; i < slot_count; ++i)
+        {
+            m_Slots[i].m_Sequence.store(i, std::memory_order_relaxed);
+            m_Slots[i].m_Data = m_Buffer.get() + i * max_line;
+        }
+    }
+
+    CSYS_INLINE bool CommandQueue::Push(std::string_view line)
+    {
+        if (line.size() > m_MaxLine) return false;
+
+        // Claim slot at tail.
+        Slot *slot;
+        size_t pos = m_Tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            slot = &m_Slots[pos & m_Mask];
+            size_t sequence = slot->m_Sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            // Slot is free, try to take it.
+            if (diff == 0)
+            {
+                if (m_Tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            // Slot still holds a line from the previous lap.
+            else if (diff < 0)
+                return false;
+            // Another producer took it.
+            else
+                pos = m_Tail.load(std::memory_order_relaxed);
+        }
+
+        // Fill and publish.
+        if (!line.empty()) std::memcpy(slot->m_Data, line.data(), line.size());
+        slot->m_Size = line.size();
+        slot->m_Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    CSYS_INLINE size_t CommandQueue::Capacity() const
+    {
+        return m_Mask + 1;
+    }
+
+    CSYS_INLINE size_t CommandQueue::MaxLine() const
+    {
+        return m_MaxLine;
+    }
+}
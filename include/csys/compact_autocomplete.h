@@ -0,0 +1,284 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_COMPACT_AUTOCOMPLETE_H
+#define CSYS_COMPACT_AUTOCOMPLETE_H
+
+#pragma once
+
+#include "csys/api.h"
+#include "csys/autocomplete.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Read-only autocomplete index. Built from an AutoComplete by merging identical subtrees into a minimized
+     *      ternary DAG stored in one flat array, which can be saved to a file and memory mapped back without
+     *      rebuilding anything
+     */
+    class CSYS_API CompactAutoComplete
+    {
+    public:
+
+        // Type definitions.
+        using r_sVector = AutoComplete::r_sVector;
+        using sVector = AutoComplete::sVector;
+        using ACNode = AutoComplete::ACNode;
+        using NodeIndex = AutoComplete::NodeIndex;
+
+        /*!
+         * \brief
+         *      Default constructor, empty index
+         */
+        CompactAutoComplete() = default;
+
+        /*!
+         * \brief
+         *      Builds a minimized index holding every word of a tree
+         * \param tree
+         *      Tree to be compacted
+         */
+        explicit CompactAutoComplete(const AutoComplete &tree);
+
+        /*!
+         * \brief
+         *      Move constructor
+         * \param rhs
+         *      Index to be moved, left empty
+         */
+        CompactAutoComplete(CompactAutoComplete &&rhs) noexcept;
+
+        /*!
+         * \brief
+         *      Move assignment operator
+         * \param rhs
+         *      Index to be moved, left empty
+         * \return
+         *      Self
+         */
+        CompactAutoComplete &operator=(CompactAutoComplete &&rhs) noexcept;
+
+        CompactAutoComplete(const CompactAutoComplete &) = delete;
+        CompactAutoComplete &operator=(const CompactAutoComplete &) = delete;
+
+        /*!
+         * \brief
+         *      Destructor, unmaps the file if mapped
+         */
+        ~CompactAutoComplete();
+
+        /*!
+         * \brief
+         *      Get index node count
+         * \return
+         *      Node count after minimization
+         */
+        [[nodiscard]] size_t Size() const;
+
+        /*!
+         * \brief
+         *      Get index word count
+         * \return
+         *      Word count
+         */
+        [[nodiscard]] size_t Count() const;
+
+        /*!
+         * \brief
+         *      Search if the given word is in the index
+         * \param[in] word
+         *      Word to search
+         * \return
+         *      Found word
+         */
+        [[nodiscard]] bool Search(const char *word) const;
+
+        /*!
+         * \brief
+         *      Retrieve suggestions that match the given prefix
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup
+         * \param[out] ac_options
+         *      Vector of found suggestions
+         */
+        void Suggestions(const char *prefix, r_sVector ac_options) const;
+
+        /*!
+         * \brief
+         *      Store suggestions that match prefix in ac_options and return partially completed prefix if possible.
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup
+         * \param[out] ac_options
+         *      Vector of found suggestions
+         * \return
+         *      Partially completed prefix
+         */
+        std::string Suggestions(const std::string &prefix, r_sVector ac_options) const;
+
+        /*!
+         * \brief
+         *      Retrieve suggestions that match the given prefix
+         * \param[in/out] prefix
+         *      Prefix to use for suggestion lookup, will be partially completed if flag partial_complete is on
+         * \param[out] ac_options
+         *      Vector of found suggestions
+         * \param[in] partial_complete
+         *      Flag to determine if prefix string will be partially completed
+         */
+        void Suggestions(std::string &prefix, r_sVector ac_options, bool partial_complete) const;
+
+        /*!
+         * \brief
+         *      Retrieve suggestions that match the given prefix
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup
+         * \return
+         *      Vector of found suggestions
+         */
+        std::unique_ptr<sVector> Suggestions(const char *prefix) const;
+
+        /*!
+         * \brief
+         *      Visits the first suggestions matching the given prefix in alphabetical order, without collecting them
+         * \tparam Visitor
+         *      Callable taking a std::string_view
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup (Empty visits every word)
+         * \param[in] max_results
+         *      Maximum number of suggestions to visit
+         * \param[in] visitor
+         *      Called with each suggestion, only valid during the call
+         * \return
+         *      Number of suggestions visited
+         */
+        template<typename Visitor>
+        size_t Suggestions(std::string_view prefix, size_t max_results, Visitor &&visitor) const
+        {
+            return AutoComplete::VisitSuggestions(m_Nodes, m_Root, prefix, max_results, visitor);
+        }
+
+        /*!
+         * \brief
+         *      Counts the suggestions matching the given prefix
+         * \param[in] prefix
+         *      Prefix to use for suggestion lookup (Empty counts every word)
+         * \return
+         *      Number of suggestions the visitor overload of Suggestions would visit without a limit
+         */
+        [[nodiscard]] size_t SuggestionCount(std::string_view prefix) const;
+
+        /*!
+         * \brief
+         *      Retrieve words within an edit distance of the given query, tolerating typos
+         * \param[in] query
+         *      Possibly misspelled word
+         * \param[in] max_distance
+         *      Maximum number of insertions, deletions, substitutions and adjacent transpositions
+         * \param[in] max_results
+         *      Maximum number of words retrieved
+         * \param[out] ac_options
+         *      Found words, closest first, then shortest, then alphabetical
+         */
+        void FuzzySuggestions(std::string_view query, size_t max_distance, size_t max_results, r_sVector ac_options) const;
+
+        /*!
+         * \brief
+         *      Writes the index to a file
+         * \param path
+         *      Path of the file
+         * \return
+         *      False if the file couldn't be written
+         */
+        bool Save(const std::string &path) const;
+
+        /*!
+         * \brief
+         *      Replaces this index by one saved to a file, mapping it into memory instead of reading it
+         * \param path
+         *      Path of a file written by Save on a machine of the same byte order
+         * \return
+         *      False if the file couldn't be opened or isn't a valid index, the index is left empty
+         */
+        bool Map(const std::string &path);
+
+    protected:
+
+        /*!
+         * \brief
+         *      Saved file header, followed by the node array
+         */
+        struct FileHeader
+        {
+            char m_Magic[8];           //!< "CSYSACX" followed by a null terminator
+            uint32_t m_ByteOrder;      //!< 0x01020304 as written by the saving machine
+            uint32_t m_NodeSize;       //!< sizeof(ACNode)
+            uint32_t m_NodeCount;      //!< Nodes in the array, NIL slot included
+            uint32_t m_Root;           //!< Root node
+            uint64_t m_Count;          //!< Word count
+        };
+
+        //!< Hashes a node by content.
+        struct NodeHash
+        {
+            size_t operator()(const ACNode &node) const;
+        };
+
+        //!< Compares nodes by content.
+        struct NodeEqual
+        {
+            bool operator()(const ACNode &lhs, const ACNode &rhs) const;
+        };
+
+        using UniqueNodes = std::unordered_map<ACNode, NodeIndex, NodeHash, NodeEqual>;    //!< Copied nodes by content
+
+        /*!
+         * \brief
+         *      Copies a subtree into m_Storage, reusing an identical copied subtree if there is one
+         * \param tree
+         *      Source tree
+         * \param root
+         *      Subtree root in the source tree
+         * \param[in/out] unique
+         *      Copied nodes by content
+         * \return
+         *      Index of the subtree root in m_Storage
+         */
+        NodeIndex Minimize(const AutoComplete &tree, NodeIndex root, UniqueNodes &unique);
+
+        /*!
+         * \param[in] root
+         *      Permutation root
+         * \param[out] ac_options
+         *      Vector of found suggestions
+         * \param[in] buffer
+         *      Prefix buffer, restored before returning
+         */
+        void SuggestionsAux(NodeIndex root, r_sVector ac_options, std::string &buffer) const;
+
+        /*!
+         * \brief
+         *      Releases storage and mapping, leaving the index empty
+         */
+        void Clear();
+
+        std::vector<ACNode> m_Storage;            //!< Owned nodes (Empty if mapped)
+        const ACNode *m_Nodes = nullptr;          //!< Node array, owned or mapped
+        size_t m_Size = 0;                        //!< Node count (NIL slot excluded)
+        size_t m_Count = 0;                       //!< Word count
+        NodeIndex m_Root = AutoComplete::NIL;     //!< Root node
+        void *m_Mapping = nullptr;                //!< Mapped file view (Null if owned)
+        size_t m_MappingSize = 0;                 //!< Size of the mapped view
+    };
+}
+
+#ifdef CSYS_HEADER_ONLY
+#include "csys/compact_autocomplete.inl"
+#endif
+
+#endif //CSYS_COMPACT_AUTOCOMPLETE_H
@@ -0,0 +1,374 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#ifndef CSYS_HEADER_ONLY
+
+#include "csys/compact_autocomplete.h"
+
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace csys
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Constructor/Destructors ////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE CompactAutoComplete::CompactAutoComplete(const AutoComplete &tree) : m_Count(tree.m_Count)
+    {
+        // Children are copied before their parents, so identical subtrees collapse bottom up.
+        UniqueNodes unique(tree.m_Size);
+        m_Storage.reserve(tree.m_Size + 1);
+        m_Storage.emplace_back('\0');
+        m_Root = Minimize(tree, tree.m_Root, unique);
+        m_Storage.shrink_to_fit();
+        m_Nodes = m_Storage.data();
+        m_Size = m_Storage.size() - 1;
+    }
+
+    CSYS_INLINE CompactAutoComplete::CompactAutoComplete(CompactAutoComplete &&rhs) noexcept
+    {
+        *this = std::move(rhs);
+    }
+
+    CSYS_INLINE CompactAutoComplete &CompactAutoComplete::operator=(CompactAutoComplete &&rhs) noexcept
+    {
+        // Prevent self assignment.
+        if (&rhs == this) return *this;
+
+        Clear();
+
+        // Vector storage doesn't move on move, so m_Nodes stays valid.
+        m_Storage = std::move(rhs.m_Storage);
+        m_Nodes = std::exchange(rhs.m_Nodes, nullptr);
+        m_Size = std::exchange(rhs.m_Size, 0);
+        m_Count = std::exchange(rhs.m_Count, 0);
+        m_Root = std::exchange(rhs.m_Root, AutoComplete::NIL);
+        m_Mapping = std::exchange(rhs.m_Mapping, nullptr);
+        m_MappingSize = std::exchange(rhs.m_MappingSize, 0);
+        rhs.m_Storage.clear();
+
+        return *this;
+    }
+
+    CSYS_INLINE CompactAutoComplete::~CompactAutoComplete()
+    {
+        Clear();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Public methods /////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE size_t CompactAutoComplete::Size() const
+    {
+        return m_Size;
+    }
+
+    CSYS_INLINE size_t CompactAutoComplete::Count() const
+    {
+        return m_Count;
+    }
+
+    CSYS_INLINE bool CompactAutoComplete::Search(const char *word) const
+    {
+        NodeIndex index = m_Root;
+
+        // Traverse index in look for the given string.
+        while (index != AutoComplete::NIL)
+        {
+            const ACNode &node = m_Nodes[index];
+            if (*word < node.m_Data)
+            {
+                index = node.m_Less;
+            } else if (*word == node.m_Data)
+            {
+                // Word was found.
+                if (*(word + 1) == '\0' && node.m_IsWord)
+                    return true;
+
+                index = node.m_Equal;
+                ++word;
+            } else
+            {
+                index = node.m_Greater;
+            }
+        }
+
+        return false;
+    }
+
+    CSYS_INLINE void CompactAutoComplete::Suggestions(const char *prefix, r_sVector ac_options) const
+    {
+        std::string temp = prefix;
+        Suggestions(temp, ac_options, false);
+    }
+
+    CSYS_INLINE std::string CompactAutoComplete::Suggestions(const std::string &prefix, r_sVector ac_options) const
+    {
+        std::string temp = prefix;
+        Suggestions(temp, ac_options, true);
+        return temp;
+    }
+
+    CSYS_INLINE void CompactAutoComplete::Suggestions(std::string &prefix, r_sVector ac_options, bool partial_complete) const
+    {
+        NodeIndex index = m_Root;
+        const char *temp = prefix.c_str();
+        size_t prefix_end = prefix.size();
+
+        // Traverse index and check if prefix exists.
+        while (index != AutoComplete::NIL)
+        {
+            const ACNode &node = m_Nodes[index];
+            if (*temp < node.m_Data)
+            {
+                index = node.m_Less;
+            } else if (*temp == node.m_Data)
+            {
+                // Prefix exists in index.
+                if (*(temp + 1) == '\0')
+                    break;
+
+                index = node.m_Equal;
+                ++temp;
+            } else
+            {
+                index = node.m_Greater;
+            }
+        }
+
+        // Prefix is not in index.
+        if (index == AutoComplete::NIL) return;
+
+        // Get partially completed string.
+        if (partial_complete)
+        {
+            NodeIndex pc_index = m_Nodes[index].m_Equal;
+            while (pc_index != AutoComplete::NIL)
+            {
+                const ACNode &pc_node = m_Nodes[pc_index];
+                if (pc_node.m_Equal != AutoComplete::NIL && pc_node.m_Less == AutoComplete::NIL &&
+                    pc_node.m_Greater == AutoComplete::NIL)
+                    prefix.push_back(pc_node.m_Data);
+                else
+                    break;
+
+                pc_index = pc_node.m_Equal;
+            }
+        }
+
+        // Already a word. (No need to auto complete).
+        if (m_Nodes[index].m_IsWord) return;
+
+        // Retrieve auto complete options.
+        std::string buffer = prefix.substr(0, prefix_end);
+        SuggestionsAux(m_Nodes[index].m_Equal, ac_options, buffer);
+    }
+
+    CSYS_INLINE std::unique_ptr<CompactAutoComplete::sVector> CompactAutoComplete::Suggestions(const char *prefix) const
+    {
+        auto temp = std::make_unique<sVector>();
+        Suggestions(prefix, *temp);
+        return temp;
+    }
+
+    CSYS_INLINE size_t CompactAutoComplete::SuggestionCount(std::string_view prefix) const
+    {
+        return AutoComplete::CountAux(m_Nodes, prefix.empty() ? m_Root : AutoComplete::FindCompletions(m_Nodes, m_Root, prefix));
+    }
+
+    CSYS_INLINE void CompactAutoComplete::FuzzySuggestions(std::string_view query, size_t max_distance,
+                                                           size_t max_results, r_sVector ac_options) const
+    {
+        AutoComplete::FuzzySuggestions(m_Nodes, m_Root, query, max_distance, max_results, ac_options);
+    }
+
+    CSYS_INLINE bool CompactAutoComplete::Save(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.good()) return false;
+
+        // Header.
+        FileHeader header{};
+        std::memcpy(header.m_Magic, "CSYSACX", sizeof(header.m_Magic));
+        header.m_ByteOrder = 0x01020304;
+        header.m_NodeSize = uint32_t(sizeof(ACNode));
+        header.m_NodeCount = uint32_t(m_Size + 1);
+        header.m_Root = m_Root;
+        header.m_Count = m_Count;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        // Nodes, an empty index still stores its NIL slot.
+        const ACNode nil('\0');
+        const ACNode *nodes = m_Nodes ? m_Nodes : &nil;
+        file.write(reinterpret_cast<const char *>(nodes), std::streamsize(sizeof(ACNode) * header.m_NodeCount));
+
+        return file.good();
+    }
+
+    CSYS_INLINE bool CompactAutoComplete::Map(const std::string &path)
+    {
+        Clear();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+        {
+            m_Mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            m_MappingSize = size_t(size.QuadPart);
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) return false;
+
+        struct stat info{};
+        if (fstat(file, &info) == 0 && info.st_size > 0)
+        {
+            void *view = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (view != MAP_FAILED)
+            {
+                m_Mapping = view;
+                m_MappingSize = size_t(info.st_size);
+            }
+        }
+        close(file);
+#endif
+
+        if (!m_Mapping)
+        {
+            m_MappingSize = 0;
+            return false;
+        }
+
+        // Validate header.
+        FileHeader header{};
+        bool valid = m_MappingSize >= sizeof(FileHeader);
+        if (valid)
+        {
+            std::memcpy(&header, m_Mapping, sizeof(header));
+            valid = std::memcmp(header.m_Magic, "CSYSACX", sizeof(header.m_Magic)) == 0 &&
+                    header.m_ByteOrder == 0x01020304 && header.m_NodeSize == sizeof(ACNode) && header.m_NodeCount > 0 &&
+                    header.m_Root < header.m_NodeCount &&
+                    m_MappingSize >= sizeof(FileHeader) + size_t(header.m_NodeCount) * sizeof(ACNode);
+        }
+        if (!valid)
+        {
+            Clear();
+            return false;
+        }
+
+        // Save writes children before parents, so links only point to lower nodes (No cycles or overruns).
+        auto nodes = reinterpret_cast<const ACNode *>(static_cast<const char *>(m_Mapping) + sizeof(FileHeader));
+        for (NodeIndex i = 1; i < header.m_NodeCount; ++i)
+        {
+            for (NodeIndex child : {nodes[i].m_Less, nodes[i].m_Equal, nodes[i].m_Greater})
+            {
+                if (child >= i)
+                {
+                    Clear();
+                    return false;
+                }
+            }
+        }
+
+        m_Nodes = nodes;
+        m_Size = header.m_NodeCount - 1;
+        m_Count = size_t(header.m_Count);
+        m_Root = header.m_Root;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Private methods ////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE size_t CompactAutoComplete::NodeHash::operator()(const ACNode &node) const
+    {
+        size_t hash = size_t(static_cast<unsigned char>(node.m_Data)) << 1 | size_t(node.m_IsWord);
+        for (NodeIndex child : {node.m_Less, node.m_Equal, node.m_Greater})
+            hash = (hash ^ child) * size_t(0x100000001b3ULL);
+        return hash;
+    }
+
+    CSYS_INLINE bool CompactAutoComplete::NodeEqual::operator()(const ACNode &lhs, const ACNode &rhs) const
+    {
+        return lhs.m_Data == rhs.m_Data && lhs.m_IsWord == rhs.m_IsWord && lhs.m_Less == rhs.m_Less &&
+               lhs.m_Equal == rhs.m_Equal && lhs.m_Greater == rhs.m_Greater;
+    }
+
+    CSYS_INLINE CompactAutoComplete::NodeIndex CompactAutoComplete::Minimize(const AutoComplete &tree, NodeIndex root,
+                                                                             UniqueNodes &unique)
+    {
+        if (root == AutoComplete::NIL) return AutoComplete::NIL;
+        const ACNode &source = tree.m_Nodes[root];
+
+        // Node with its children already replaced by their copies.
+        ACNode node(source.m_Data, source.m_IsWord);
+        node.m_Less = Minimize(tree, source.m_Less, unique);
+        node.m_Equal = Minimize(tree, source.m_Equal, unique);
+        node.m_Greater = Minimize(tree, source.m_Greater, unique);
+
+        // Share an identical subtree.
+        auto result = unique.emplace(node, NodeIndex(m_Storage.size()));
+        if (result.second)
+            m_Storage.push_back(node);
+        return result.first->second;
+    }
+
+    CSYS_INLINE void CompactAutoComplete::SuggestionsAux(NodeIndex root, r_sVector ac_options, std::string &buffer) const
+    {
+        // Collect every word.
+        size_t remaining = SIZE_MAX;
+        auto collect = [&ac_options](std::string_view word) { ac_options.emplace_back(word); };
+        AutoComplete::VisitAux(m_Nodes, root, buffer, remaining, collect);
+    }
+
+    CSYS_INLINE void CompactAutoComplete::Clear()
+    {
+        if (m_Mapping)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(m_Mapping);
+#else
+            munmap(m_Mapping, m_MappingSize);
+#endif
+        }
+
+        m_Storage.clear();
+        m_Storage.shrink_to_fit();
+        m_Nodes = nullptr;
+        m_Size = 0;
+        m_Count = 0;
+        m_Root = AutoComplete::NIL;
+        m_Mapping = nullptr;
+        m_MappingSize = 0;
+    }
+}
@@ -8,8 +8,34 @@
 #include <string>
 #include <exception>
 #include <utility>
+#include <cstdio>
+#include <cstdlib>
 #include "csys/api.h"
 
+// Build without exceptions when the compiler has them disabled (-fno-exceptions)
+#if !defined(CSYS_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#  define CSYS_NO_EXCEPTIONS
+#endif
+
+// Error handling macros, without exceptions errors that would throw print their message and abort. CSYS_CATCH only
+// takes a csys::Exception (or base) declaration, its block is never entered without exceptions
+#ifdef CSYS_NO_EXCEPTIONS
+#  define CSYS_TRY if (true)
+#  define CSYS_CATCH_ALL else
+#  define CSYS_CATCH(DECLARATION) else if (false) for (DECLARATION = csys::Exception(""); false;)
+#  define CSYS_THROW(EXCEPTION) \
+    do \
+    { \
+      std::fprintf(stderr, "csys: %s\n", (EXCEPTION).what()); \
+      std::abort(); \
+    } while (0)
+#else
+#  define CSYS_TRY try
+#  define CSYS_CATCH_ALL catch (...)
+#  define CSYS_CATCH(DECLARATION) catch (DECLARATION)
+#  define CSYS_THROW(EXCEPTION) throw(EXCEPTION)
+#endif
+
 namespace csys
 {
     /*!
@@ -0,0 +1,278 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_FROZEN_COMMANDS_H
+#define CSYS_FROZEN_COMMANDS_H
+#pragma once
+
+#include "csys/api.h"
+#include "csys/command.h"
+#include "csys/variable.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Word a registered command is invoked with:
+     *          - None: Plain command ("name").
+     *          - Set: Variable setter ("set name").
+     *          - Get: Variable getter ("get name").
+     *          - Help: Command help ("help name").
+     */
+    enum class CommandVerb : unsigned char
+    {
+        NONE = 0,
+        SET,
+        GET,
+        HELP
+    };
+
+    /*!
+     * \brief
+     *      Non-owning composite key, used to look up commands without building strings
+     */
+    struct CommandKeyView
+    {
+        CommandVerb m_Verb;         //!< Verb command is invoked with
+        std::string_view m_Name;    //!< Command or variable name
+    };
+
+    /*!
+     * \brief
+     *      Composite key of a registered command
+     */
+    struct CommandKey
+    {
+        /*!
+         * \brief
+         *      Constructor
+         * \param verb
+         *      Verb command is invoked with
+         * \param name
+         *      Command or variable name
+         */
+        CommandKey(CommandVerb verb, std::string name) : m_Verb(verb), m_Name(std::move(name))
+        {}
+
+        /*!
+         * \brief
+         *      Key as a view
+         * \return
+         *      Verb and name (The name searched for if this is a lookup key)
+         */
+        [[nodiscard]] CommandKeyView View() const
+        {
+            return CommandKeyView{m_Verb, m_Lookup ? m_LookupName : std::string_view(m_Name)};
+        }
+
+        CommandVerb m_Verb;    //!< Verb command is invoked with
+        std::string m_Name;    //!< Command or variable name
+
+    private:
+        friend class CommandMap;
+
+        /*!
+         * \brief
+         *      Key referring to the name of a view instead of owning it, only used to search the map
+         * \param key
+         *      Key to search for
+         */
+        explicit CommandKey(const CommandKeyView &key) : m_Verb(key.m_Verb), m_Lookup(true), m_LookupName(key.m_Name)
+        {}
+
+        bool m_Lookup = false;             //!< Flag to determine if this is a lookup key
+        std::string_view m_LookupName;     //!< Name searched for by a lookup key
+    };
+
+    /*!
+     * \brief
+     *      Hash of a CommandKey, from its verb and name
+     */
+    struct CommandKeyHash
+    {
+        size_t operator()(const CommandKey &key) const
+        {
+            CommandKeyView view = key.View();
+            size_t hash = std::hash<std::string_view>()(view.m_Name);
+            return hash ^ (size_t(view.m_Verb) + 0x9E3779B9 + (hash << 6) + (hash >> 2));
+        }
+    };
+
+    /*!
+     * \brief
+     *      Equality of CommandKeys, compares their verb and name
+     */
+    struct CommandKeyEqual
+    {
+        bool operator()(const CommandKey &lhs, const CommandKey &rhs) const
+        {
+            CommandKeyView l = lhs.View(), r = rhs.View();
+            return l.m_Verb == r.m_Verb && l.m_Name == r.m_Name;
+        }
+    };
+
+    /*!
+     * \brief
+     *      Registered commands container, hash map keyed by verb and name that can also be searched with a
+     *      CommandKeyView without building a string
+     */
+    class CommandMap
+            : public std::unordered_map<CommandKey, std::shared_ptr<CommandBase>, CommandKeyHash, CommandKeyEqual>
+    {
+    public:
+        using unordered_map::find;
+
+        /*!
+         * \brief
+         *      Look up a command without copying its name
+         * \param key
+         *      Verb and name of the command
+         * \return
+         *      Iterator to the command, or end
+         */
+        iterator find(const CommandKeyView &key)
+        {
+            return find(CommandKey(key));
+        }
+
+        /*!
+         * \brief
+         *      Look up a command without copying its name
+         * \param key
+         *      Verb and name of the command
+         * \return
+         *      Iterator to the command, or end
+         */
+        const_iterator find(const CommandKeyView &key) const
+        {
+            return find(CommandKey(key));
+        }
+    };
+
+    /*!
+     * \brief
+     *      Read-only snapshot of the command and variable containers indexed by a collision-free (perfect) hash.
+     *      Built with the hash and displace method: keys are grouped in buckets, and every bucket gets a seed so that
+     *      all of its keys land in distinct free slots. A lookup is one hash, one seed read and one key comparison.
+     *
+     * \note
+     *      Entries are iterators into the containers the table was built from. The table must be cleared or rebuilt
+     *      whenever they are modified.
+     */
+    class CSYS_API FrozenCommands
+    {
+    public:
+
+        /*!
+         * \brief
+         *      Build table over every entry of the given containers
+         * \param commands
+         *      Commands to index
+         * \param variables
+         *      Variables to index
+         * \note
+         *      Table is left empty if the keys could not be placed (Only possible with full 64-bit hash collisions)
+         */
+        void Build(CommandMap &commands, VariableMap &variables);
+
+        /*!
+         * \brief Release table
+         */
+        void Clear();
+
+        /*!
+         * \brief
+         *      Check if the table has been built
+         * \return
+         *      True if table is empty
+         */
+        [[nodiscard]] bool Empty() const;
+
+        /*!
+         * \brief
+         *      Look up a command
+         * \param key
+         *      Key of the command
+         * \param not_found
+         *      Value returned if key is not in the table (Usually end of the indexed container)
+         * \return
+         *      Iterator to the command in the indexed container
+         */
+        [[nodiscard]] CommandMap::iterator Find(const CommandKeyView &key, CommandMap::iterator not_found) const;
+
+        /*!
+         * \brief
+         *      Look up a variable
+         * \param name
+         *      Name of the variable
+         * \param not_found
+         *      Value returned if name is not in the table (Usually end of the indexed container)
+         * \return
+         *      Iterator to the variable in the indexed container
+         */
+        [[nodiscard]] VariableMap::iterator Find(std::string_view name, VariableMap::iterator not_found) const;
+
+    protected:
+
+        //!< Table slot.
+        struct Slot
+        {
+            uint64_t m_Hash = 0;                //!< Full key hash (Used to reject most misses without comparing names)
+            bool m_Used = false;                //!< Flag to determine if slot holds an entry
+            CommandKeyView m_Key{};             //!< Indexed key (Variables use the set verb)
+            CommandMap::iterator m_Command;     //!< Indexed command
+            VariableMap::iterator m_Variable;   //!< Indexed variable
+        };
+
+        /*!
+         * \brief
+         *      Find slot holding a key
+         * \param key
+         *      Key to look up
+         * \return
+         *      Slot holding key, or nullptr if key is not in the table
+         */
+        [[nodiscard]] const Slot *FindSlot(const CommandKeyView &key) const;
+
+        /*!
+         * \brief
+         *      Hash of a key
+         * \param key
+         *      Key to hash
+         * \return
+         *      64-bit hash
+         */
+        static uint64_t Hash(const CommandKeyView &key);
+
+        /*!
+         * \brief
+         *      Slot of a key hash for a given bucket seed
+         * \param hash
+         *      Key hash
+         * \param seed
+         *      Bucket seed
+         * \param slots
+         *      Slot count
+         * \return
+         *      Slot index
+         */
+        static size_t SlotIndex(uint64_t hash, uint32_t seed, size_t slots);
+
+        std::vector<uint32_t> m_Seeds;    //!< Per bucket seeds
+        std::vector<Slot> m_Slots;        //!< Table slots
+    };
+}
+
+#ifdef CSYS_HEADER_ONLY
+#include "csys/frozen_commands.inl"
+#endif
+
+#endif //CSYS_FROZEN_COMMANDS_H
@@ -0,0 +1,173 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#ifndef CSYS_HEADER_ONLY
+
+#include "csys/frozen_commands.h"
+
+#endif
+
+#include <algorithm>
+
+namespace csys
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Public methods /////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE void FrozenCommands::Build(CommandMap &commands, VariableMap &variables)
+    {
+        Clear();
+        if (commands.empty() && variables.empty()) return;
+
+        // Hash keys once.
+        std::vector<std::pair<uint64_t, Slot>> keys;
+        keys.reserve(commands.size() + variables.size());
+        for (auto it = commands.begin(); it != commands.end(); ++it)
+        {
+            Slot slot{0, true, CommandKeyView{it->first.m_Verb, it->first.m_Name}, it, variables.end()};
+            slot.m_Hash = Hash(slot.m_Key);
+            keys.emplace_back(slot.m_Hash, slot);
+        }
+        for (auto it = variables.begin(); it != variables.end(); ++it)
+        {
+            Slot slot{0, true, CommandKeyView{CommandVerb::SET, it->first}, commands.end(), it};
+            slot.m_Hash = Hash(slot.m_Key);
+            keys.emplace_back(slot.m_Hash, slot);
+        }
+
+        // Around four keys per bucket, and a 0.8 load factor.
+        const size_t bucket_count = keys.size() / 4 + 1;
+        size_t slot_count = keys.size() + keys.size() / 4 + 1;
+
+        while (true)
+        {
+            // Group keys by bucket, and place the biggest buckets first while the table is still empty.
+            std::vector<std::vector<size_t>> buckets(bucket_count);
+            for (size_t i = 0; i < keys.size(); ++i)
+                buckets[keys[i].first % bucket_count].push_back(i);
+
+            std::vector<size_t> order(bucket_count);
+            for (size_t i = 0; i < bucket_count; ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs)
+            { return buckets[lhs].size() > buckets[rhs].size(); });
+
+            m_Seeds.assign(bucket_count, 0);
+            m_Slots.assign(slot_count, Slot());
+
+            bool placed_all = true;
+            std::vector<size_t> candidate;
+            for (size_t bucket : order)
+            {
+                if (buckets[bucket].empty()) break;
+
+                // Find a seed that sends every key of the bucket to a distinct free slot.
+                bool placed = false;
+                for (uint32_t seed = 0; seed < (1u << 16) && !placed; ++seed)
+                {
+                    candidate.clear();
+                    placed = true;
+                    for (size_t key : buckets[bucket])
+                    {
+                        size_t slot = SlotIndex(keys[key].first, seed, slot_count);
+                        if (m_Slots[slot].m_Used || std::find(candidate.begin(), candidate.end(), slot) != candidate.end())
+                        {
+                            placed = false;
+                            break;
+                        }
+                        candidate.push_back(slot);
+                    }
+
+                    // Claim slots.
+                    if (placed)
+                    {
+                        m_Seeds[bucket] = seed;
+                        for (size_t i = 0; i < candidate.size(); ++i)
+                            m_Slots[candidate[i]] = keys[buckets[bucket][i]].second;
+                    }
+                }
+
+                if (!placed)
+                {
+                    placed_all = false;
+                    break;
+                }
+            }
+
+            if (placed_all) return;
+
+            // Unlucky, retry with more room. Give up (stay empty) if keys can't be told apart by their hash.
+            slot_count += slot_count / 2;
+            if (slot_count > keys.size() * 8 + 64)
+            {
+                Clear();
+                return;
+            }
+        }
+    }
+
+    CSYS_INLINE void FrozenCommands::Clear()
+    {
+        m_Seeds.clear();
+        m_Slots.clear();
+    }
+
+    CSYS_INLINE bool FrozenCommands::Empty() const
+    {
+        return m_Slots.empty();
+    }
+
+    CSYS_INLINE CommandMap::iterator FrozenCommands::Find(const CommandKeyView &key, CommandMap::iterator not_found) const
+    {
+        const Slot *slot = FindSlot(key);
+        return slot ? slot->m_Command : not_found;
+    }
+
+    CSYS_INLINE VariableMap::iterator FrozenCommands::Find(std::string_view name, VariableMap::iterator not_found) const
+    {
+        const Slot *slot = FindSlot(CommandKeyView{CommandVerb::SET, name});
+        return slot ? slot->m_Variable : not_found;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Private methods ////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE const FrozenCommands::Slot *FrozenCommands::FindSlot(const CommandKeyView &key) const
+    {
+        if (m_Slots.empty()) return nullptr;
+
+        const uint64_t hash = Hash(key);
+        const Slot &slot = m_Slots[SlotIndex(hash, m_Seeds[hash % m_Seeds.size()], m_Slots.size())];
+
+        // Not a key of the table.
+        if (!slot.m_Used || slot.m_Hash != hash || slot.m_Key.m_Verb != key.m_Verb || slot.m_Key.m_Name != key.m_Name)
+            return nullptr;
+
+        return &slot;
+    }
+
+    CSYS_INLINE uint64_t FrozenCommands::Hash(const CommandKeyView &key)
+    {
+        // FNV-1a.
+        uint64_t hash = 14695981039346656037ull ^ static_cast<uint64_t>(key.m_Verb);
+        for (char c : key.m_Name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    CSYS_INLINE size_t FrozenCommands::SlotIndex(uint64_t hash, uint32_t seed, size_t slots)
+    {
+        // SplitMix64 finalizer over seeded hash.
+        uint64_t x = hash + (static_cast<uint64_t>(seed) + 1) * 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return static_cast<size_t>(x % slots);
+    }
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "csys/api.h"
 
@@ -61,7 +62,7 @@ namespace csys
          * \param line
          *      Command string to be recorded.
          */
-        void PushBack(const std::string &line);
+        void PushBack(std::string_view line);
 
         /*!
          * \brief
@@ -22,9 +22,10 @@ namespace csys
     {
     }
 
-    CSYS_INLINE void CommandHistory::PushBack(const std::string &line)
+    CSYS_INLINE void CommandHistory::PushBack(std::string_view line)
     {
-        m_History[m_Record++ % m_MaxRecord] = line;
+        // Reuse the slot's buffer.
+        m_History[m_Record++ % m_MaxRecord].assign(line);
     }
 
     CSYS_INLINE unsigned int CommandHistory::GetNewIndex() const
@@ -0,0 +1,297 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_SCAN_H
+#define CSYS_SCAN_H
+#pragma once
+
+#include "csys/api.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Pick the widest instruction set the build targets, define CSYS_NO_SIMD to only use the scalar loops
+#if !defined(CSYS_NO_SIMD) && defined(__AVX2__)
+#  define CSYS_SCAN_AVX2
+#  include <immintrin.h>
+#elif !defined(CSYS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define CSYS_SCAN_SSE2
+#  include <emmintrin.h>
+#endif
+
+#if (defined(CSYS_SCAN_AVX2) || defined(CSYS_SCAN_SSE2)) && defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#endif
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Scanners for the chars separating and structuring command lines. Whitespace is a fixed ASCII set, ' ', '\t',
+     *      '\n', '\v', '\f', '\r' and '\0', so results never depend on the global C locale. Input is checked a block of
+     *      16 (SSE2) or 32 (AVX2) chars at a time when the build targets those instruction sets, the rest one char at
+     *      a time
+     */
+    struct CSYS_API Scan
+    {
+#if defined(CSYS_SCAN_AVX2)
+        static constexpr const char *s_Backend = "avx2";      //!< Instruction set used to scan
+#elif defined(CSYS_SCAN_SSE2)
+        static constexpr const char *s_Backend = "sse2";      //!< Instruction set used to scan
+#else
+        static constexpr const char *s_Backend = "scalar";    //!< Instruction set used to scan
+#endif
+
+        /*!
+         * \brief
+         *      Checks if a char is whitespace
+         * \param c
+         *      Char to check
+         * \return
+         *      Returns true for ' ', '\t', '\n', '\v', '\f', '\r' and '\0'
+         */
+        static inline bool IsSpace(char c)
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r') || c == '\0';
+        }
+
+        /*!
+         * \brief
+         *      Finds the first non-whitespace char
+         * \param str
+         *      String to scan
+         * \param pos
+         *      Where to start scanning from
+         * \return
+         *      Position of the char, or the size of str if only whitespace is left
+         */
+        static inline size_t SkipSpace(std::string_view str, size_t pos)
+        {
+            return Find<true, true>(str, pos);
+        }
+
+        /*!
+         * \brief
+         *      Finds the first whitespace char, or one of the given chars
+         * \tparam Chars
+         *      Chars that also stop the scan
+         * \param str
+         *      String to scan
+         * \param pos
+         *      Where to start scanning from
+         * \return
+         *      Position of the char, or the size of str if none was found
+         */
+        template<char... Chars>
+        static inline size_t FindSpaceOr(std::string_view str, size_t pos)
+        {
+            return Find<false, true, Chars...>(str, pos);
+        }
+
+        /*!
+         * \brief
+         *      Finds the first whitespace char
+         * \param str
+         *      String to scan
+         * \param pos
+         *      Where to start scanning from
+         * \return
+         *      Position of the char, or the size of str if none was found
+         */
+        static inline size_t FindSpace(std::string_view str, size_t pos)
+        {
+            return FindSpaceOr<>(str, pos);
+        }
+
+        /*!
+         * \brief
+         *      Finds the first of the given chars
+         * \tparam Chars
+         *      Chars to look for
+         * \param str
+         *      String to scan
+         * \param pos
+         *      Where to start scanning from
+         * \return
+         *      Position of the char, or the size of str if none was found
+         */
+        template<char... Chars>
+        static inline size_t FindAny(std::string_view str, size_t pos)
+        {
+            static_assert(sizeof...(Chars) > 0, "At least one char must be looked for");
+            return Find<false, false, Chars...>(str, pos);
+        }
+
+        // Delete unwanted operations
+        Scan() = delete;
+        ~Scan() = delete;
+        Scan(Scan&&) = delete;
+        Scan(const Scan&) = delete;
+        Scan& operator=(Scan&&) = delete;
+        Scan& operator=(const Scan&) = delete;
+
+    private:
+
+        static constexpr size_t s_Head = 8;    //!< Chars checked one at a time first, arguments are mostly short
+
+        /*!
+         * \brief
+         *      Checks if a char is whitespace or one of the given chars
+         * \tparam Invert
+         *      True to check for the opposite
+         * \tparam Spaces
+         *      True if whitespace is accepted
+         * \tparam Chars
+         *      Other accepted chars
+         * \param c
+         *      Char to check
+         * \return
+         *      Returns true if accepted
+         */
+        template<bool Invert, bool Spaces, char... Chars>
+        static inline bool Match(char c)
+        {
+            return Invert != ((Spaces && IsSpace(c)) || ((c == Chars) || ...));
+        }
+
+        /*!
+         * \brief
+         *      Finds the first char that is whitespace or one of the given chars
+         * \tparam Invert
+         *      True to find the first char that isn't
+         * \tparam Spaces
+         *      True if whitespace is looked for
+         * \tparam Chars
+         *      Other chars looked for
+         * \param str
+         *      String to scan
+         * \param pos
+         *      Where to start scanning from
+         * \return
+         *      Position of the char, or the size of str if none was found
+         */
+        template<bool Invert, bool Spaces, char... Chars>
+        static inline size_t Find(std::string_view str, size_t pos)
+        {
+            size_t head = pos + s_Head < str.size() ? pos + s_Head : str.size();
+            for (; pos < head; ++pos)
+                if (Match<Invert, Spaces, Chars...>(str[pos]))
+                    return pos;
+            return pos < str.size() ? FindLong<Invert, Spaces, Chars...>(str, pos) : str.size();
+        }
+
+        /*!
+         * \brief
+         *      Same as Find, kept apart so the short scan of Find is inlined
+         */
+        template<bool Invert, bool Spaces, char... Chars>
+        static size_t FindLong(std::string_view str, size_t pos)
+        {
+#if defined(CSYS_SCAN_AVX2) || defined(CSYS_SCAN_SSE2)
+            for (; pos + s_Width <= str.size(); pos += s_Width)
+            {
+                Block block = Load(str.data() + pos);
+                uint32_t bits = (Spaces ? Space(block) : 0u) | Any<Chars...>(block);
+                if ((bits = Invert ? ~bits & s_Full : bits) != 0)
+                    return pos + TrailingZeros(bits);
+            }
+#endif
+            for (; pos < str.size(); ++pos)
+                if (Match<Invert, Spaces, Chars...>(str[pos]))
+                    return pos;
+            return str.size();
+        }
+
+#if defined(CSYS_SCAN_AVX2)
+        using Block = __m256i;                                //!< Chars checked at once
+        static constexpr size_t s_Width = 32;                 //!< Chars in a block
+        static constexpr uint32_t s_Full = 0xFFFFFFFF;        //!< Bits of a block
+
+        static inline Block Load(const char *data)
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data)); }
+
+        static inline Block Splat(char c)
+        { return _mm256_set1_epi8(c); }
+
+        static inline uint32_t Equal(Block block, char c)
+        { return uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, Splat(c)))); }
+
+        static inline uint32_t InRange(Block block, char first, char last)
+        {
+            Block offset = _mm256_sub_epi8(block, Splat(first));
+            return uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(offset, Splat(char(last - first))), offset)));
+        }
+#elif defined(CSYS_SCAN_SSE2)
+        using Block = __m128i;                                //!< Chars checked at once
+        static constexpr size_t s_Width = 16;                 //!< Chars in a block
+        static constexpr uint32_t s_Full = 0xFFFF;            //!< Bits of a block
+
+        static inline Block Load(const char *data)
+        { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)); }
+
+        static inline Block Splat(char c)
+        { return _mm_set1_epi8(c); }
+
+        static inline uint32_t Equal(Block block, char c)
+        { return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, Splat(c)))); }
+
+        static inline uint32_t InRange(Block block, char first, char last)
+        {
+            Block offset = _mm_sub_epi8(block, Splat(first));
+            return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(offset, Splat(char(last - first))), offset)));
+        }
+#endif
+
+#if defined(CSYS_SCAN_AVX2) || defined(CSYS_SCAN_SSE2)
+        /*!
+         * \brief
+         *      Marks the whitespace of a block
+         * \param block
+         *      Chars to check
+         * \return
+         *      Bit i is set if char i is whitespace
+         */
+        static inline uint32_t Space(Block block)
+        {
+            return Equal(block, ' ') | Equal(block, '\0') | InRange(block, '\t', '\r');
+        }
+
+        /*!
+         * \brief
+         *      Marks the given chars in a block
+         * \tparam Chars
+         *      Chars to look for
+         * \param block
+         *      Chars to check
+         * \return
+         *      Bit i is set if char i is one of Chars
+         */
+        template<char... Chars>
+        static inline uint32_t Any([[maybe_unused]] Block block)
+        {
+            return (0u | ... | Equal(block, Chars));
+        }
+
+        /*!
+         * \brief
+         *      Counts the zero bits below the lowest set bit
+         * \param bits
+         *      Bits to count, must not be 0
+         * \return
+         *      Position of the lowest set bit
+         */
+        static inline size_t TrailingZeros(uint32_t bits)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return size_t(__builtin_ctz(bits));
+#endif
+        }
+#endif
+    };
+}
+
+#endif //CSYS_SCAN_H
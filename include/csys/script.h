@@ -77,9 +77,16 @@ namespace csys
         
         /*!
          * \brief Load script file
+         * \note Throws csys::Exception if the file can't be opened
          */
         void Load();
 
+        /*!
+         * \brief Load script file without throwing
+         * \return False if the file can't be opened
+         */
+        bool TryLoad();
+
         /*!
          * \brief Reload script file (Unload & Load)
          */
@@ -10,8 +10,11 @@
 #endif
 
 #include <fstream>
+#include <sstream>
+#include <string_view>
 #include <utility>
 #include "csys/exceptions.h"
+#include "csys/scan.h"
 
 namespace csys
 {
@@ -34,28 +37,40 @@ namespace csys
     {}
 
     CSYS_INLINE void Script::Load()
+    {
+        if (!TryLoad())
+            CSYS_THROW(csys::Exception("Failed to load script", m_Path));
+    }
+
+    CSYS_INLINE bool Script::TryLoad()
     {
         std::ifstream script_fstream(m_Path);
 
         // Error check.
         if (!script_fstream.good())
-            throw csys::Exception("Failed to load script", m_Path);
+            return false;
 
         // Check and open file.
         if (script_fstream.good() && script_fstream.is_open())
         {
-            // Line buffer.
-            std::string line_buf;
-
-            // Read commands.
-            while (std::getline(script_fstream, line_buf))
+            // Read the whole file at once.
+            std::ostringstream buffer;
+            buffer << script_fstream.rdbuf();
+            std::string contents = buffer.str();
+
+            // Read commands, one per line.
+            std::string_view text = contents;
+            for (size_t pos = 0; pos < text.size();)
             {
-                m_Data.emplace_back(line_buf);
+                size_t end = Scan::FindAny<'\n'>(text, pos);
+                m_Data.emplace_back(text.substr(pos, end - pos));
+                pos = end + 1;
             }
 
             // Close file.
             script_fstream.close();
         }
+        return true;
     }
 
     CSYS_INLINE void Script::Reload()
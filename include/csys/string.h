@@ -6,8 +6,10 @@
 #pragma once
 
 #include <string>
-#include <cctype>
+#include <string_view>
+#include <utility>
 #include "csys/api.h"
+#include "csys/scan.h"
 
 namespace csys
 {
@@ -47,7 +49,7 @@ namespace csys
          * \return
          *      Returns a pointer to the string contained within this string
          */
-        operator const char *()
+        operator const char *() const
         { return m_String.c_str(); }
 
         /*!
@@ -56,9 +58,18 @@ namespace csys
          * \return
          *      Returns a copy of this string
          */
-        operator std::string()
+        operator std::string() const &
         { return m_String; }
 
+        /*!
+         * \brief
+         *      Conversion constructor from a temporary csys::String to an std::string
+         * \return
+         *      Returns the string moved out of this string
+         */
+        operator std::string() &&
+        { return std::move(m_String); }
+
         /*!
          * \brief
          *      Moves until first non-whitespace char, and continues until the end of the string or a whitespace has is
@@ -70,25 +81,35 @@ namespace csys
          */
         std::pair<size_t, size_t> NextPoi(size_t &start) const
         {
-            size_t end = m_String.size();
+            return NextPoi(m_String, start);
+        }
+
+        /*!
+         * \brief
+         *      Moves until first non-whitespace char, and continues until the end of the string or a whitespace has is
+         *      found
+         * \param str
+         *      String to scan
+         * \param start
+         *      Where to start scanning from. Will be set to pair.second
+         * \return
+         *      Returns the first element and one passed the end of non-whitespace. In other words [first, second).
+         *      If only whitespace is left, first will be the size of str + 1
+         */
+        static std::pair<size_t, size_t> NextPoi(std::string_view str, size_t &start)
+        {
+            size_t end = str.size();
             std::pair<size_t, size_t> range(end + 1, end);
-            size_t pos = start;
 
             // Go to the first non-whitespace char
-            for (; pos < end; ++pos)
-                if (!std::isspace(m_String[pos]) && m_String[pos] != '\0')
-                {
-                    range.first = pos;
-                    break;
-                }
-
-            // Go to the first whitespace char
-            for (; pos < end; ++pos)
-                if (std::isspace(m_String[pos]) || m_String[pos] == '\0')
-                {
-                    range.second = pos;
-                    break;
-                }
+            size_t pos = Scan::SkipSpace(str, start);
+            if (pos < end)
+            {
+                range.first = pos;
+
+                // Go to the first whitespace char
+                range.second = Scan::FindSpace(str, pos);
+            }
 
             start = range.second;
             return range;
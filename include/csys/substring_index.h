@@ -0,0 +1,103 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_SUBSTRING_INDEX_H
+#define CSYS_SUBSTRING_INDEX_H
+#pragma once
+
+#include "csys/api.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Set of names searchable by any part of the name, not just a prefix. Every three character sequence (trigram)
+     *      of a name has a sorted list of the names holding it, a query only checks the names found in the lists of
+     *      all its trigrams. Matching ignores ASCII case
+     */
+    class CSYS_API SubstringIndex
+    {
+    public:
+
+        // Type definitions.
+        using r_sVector = std::vector<std::string> &;
+
+        /*!
+         * \brief
+         *      Get name count
+         * \return
+         *      Number of names
+         */
+        [[nodiscard]] size_t Count() const;
+
+        /*!
+         * \brief
+         *      Adds a name, nothing is done if it already is in the index
+         * \param name
+         *      Name to be added
+         */
+        void Insert(std::string_view name);
+
+        /*!
+         * \brief
+         *      Removes a name if found
+         * \param name
+         *      Name to be removed
+         */
+        void Remove(std::string_view name);
+
+        /*!
+         * \brief
+         *      Retrieve names containing the given query
+         * \param[in] query
+         *      Text to look for (Empty matches every name)
+         * \param[in] max_results
+         *      Maximum number of names retrieved
+         * \param[out] matches
+         *      Found names: the ones starting with query first, then the ones with a '_' separated token starting with
+         *      query, then the rest, alphabetical (Ignoring case) within each group
+         */
+        void Search(std::string_view query, size_t max_results, r_sVector matches) const;
+
+    protected:
+
+        using Trigram = uint32_t;    //!< Three lower cased characters
+
+        /*!
+         * \brief
+         *      Lists the distinct trigrams of a lower cased string
+         * \param str
+         *      Lower cased string
+         * \param[out] trigrams
+         *      Sorted trigrams, cleared first
+         */
+        static void Trigrams(std::string_view str, std::vector<Trigram> &trigrams);
+
+        /*!
+         * \brief
+         *      Lower cases ASCII characters
+         * \param str
+         *      String to fold
+         * \return
+         *      Folded copy
+         */
+        static std::string Fold(std::string_view str);
+
+        std::vector<std::string> m_Names;                                 //!< Names by id (Empty if the id is free)
+        std::vector<std::string> m_Folded;                                //!< Lower cased names by id
+        std::vector<uint32_t> m_FreeIds;                                  //!< Ids of removed names
+        std::unordered_map<std::string, uint32_t> m_Ids;                  //!< Id of every name
+        std::unordered_map<Trigram, std::vector<uint32_t>> m_Postings;    //!< Sorted ids of the names holding a trigram
+    };
+}
+
+#ifdef CSYS_HEADER_ONLY
+#include "csys/substring_index.inl"
+#endif
+
+#endif //CSYS_SUBSTRING_INDEX_H
@@ -0,0 +1,179 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#ifndef CSYS_HEADER_ONLY
+
+#include "csys/substring_index.h"
+
+#endif
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace csys
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Public methods /////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE size_t SubstringIndex::Count() const
+    {
+        return m_Ids.size();
+    }
+
+    CSYS_INLINE void SubstringIndex::Insert(std::string_view name)
+    {
+        // Empty names mark free ids.
+        if (name.empty() || m_Ids.find(std::string(name)) != m_Ids.end())
+            return;
+
+        // Reuse a removed name's id.
+        uint32_t id;
+        if (!m_FreeIds.empty())
+        {
+            id = m_FreeIds.back();
+            m_FreeIds.pop_back();
+            m_Names[id] = name;
+            m_Folded[id] = Fold(name);
+        } else
+        {
+            id = uint32_t(m_Names.size());
+            m_Names.emplace_back(name);
+            m_Folded.push_back(Fold(name));
+        }
+        m_Ids.emplace(std::string(name), id);
+
+        // Post id under every trigram, keeping lists sorted.
+        std::vector<Trigram> trigrams;
+        Trigrams(m_Folded[id], trigrams);
+        for (Trigram trigram : trigrams)
+        {
+            auto &list = m_Postings[trigram];
+            list.insert(std::upper_bound(list.begin(), list.end(), id), id);
+        }
+    }
+
+    CSYS_INLINE void SubstringIndex::Remove(std::string_view name)
+    {
+        auto it = m_Ids.find(std::string(name));
+        if (it == m_Ids.end())
+            return;
+
+        uint32_t id = it->second;
+        m_Ids.erase(it);
+
+        // Unpost id, dropping emptied lists.
+        std::vector<Trigram> trigrams;
+        Trigrams(m_Folded[id], trigrams);
+        for (Trigram trigram : trigrams)
+        {
+            auto list = m_Postings.find(trigram);
+            list->second.erase(std::lower_bound(list->second.begin(), list->second.end(), id));
+            if (list->second.empty())
+                m_Postings.erase(list);
+        }
+
+        m_Names[id].clear();
+        m_Folded[id].clear();
+        m_FreeIds.push_back(id);
+    }
+
+    CSYS_INLINE void SubstringIndex::Search(std::string_view query, size_t max_results, r_sVector matches) const
+    {
+        if (max_results == 0) return;
+        std::string folded = Fold(query);
+
+        // Queries without a trigram check every name.
+        std::vector<uint32_t> candidates;
+        if (folded.size() < 3)
+        {
+            for (uint32_t id = 0; id < m_Names.size(); ++id)
+                if (!m_Names[id].empty())
+                    candidates.push_back(id);
+        } else
+        {
+            // Names holding every trigram of the query, none if one is missing.
+            std::vector<Trigram> trigrams;
+            Trigrams(folded, trigrams);
+            std::vector<const std::vector<uint32_t> *> lists;
+            for (Trigram trigram : trigrams)
+            {
+                auto list = m_Postings.find(trigram);
+                if (list == m_Postings.end())
+                    return;
+                lists.push_back(&list->second);
+            }
+
+            // Shortest lists first, the intersection only shrinks.
+            std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t> *lhs, const std::vector<uint32_t> *rhs)
+            {
+                return lhs->size() < rhs->size();
+            });
+            candidates = *lists.front();
+            std::vector<uint32_t> scratch;
+            for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+            {
+                scratch.clear();
+                std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+                                      std::back_inserter(scratch));
+                candidates.swap(scratch);
+            }
+        }
+
+        // Holding every trigram doesn't make it a match, rank the ones that are.
+        std::vector<std::pair<int, uint32_t>> found;
+        for (uint32_t id : candidates)
+        {
+            const std::string &name = m_Folded[id];
+            size_t pos = name.find(folded);
+            if (pos == std::string::npos)
+                continue;
+
+            // Start of the name, then start of a token.
+            int rank = pos == 0 ? 0 : 2;
+            for (; rank == 2 && pos != std::string::npos; pos = name.find(folded, pos + 1))
+                if (name[pos - 1] == '_')
+                    rank = 1;
+
+            found.emplace_back(rank, id);
+        }
+
+        auto better = [this](const std::pair<int, uint32_t> &lhs, const std::pair<int, uint32_t> &rhs)
+        {
+            if (lhs.first != rhs.first) return lhs.first < rhs.first;
+            if (m_Folded[lhs.second] != m_Folded[rhs.second]) return m_Folded[lhs.second] < m_Folded[rhs.second];
+            return m_Names[lhs.second] < m_Names[rhs.second];
+        };
+        size_t count = std::min(max_results, found.size());
+        std::partial_sort(found.begin(), found.begin() + long(count), found.end(), better);
+
+        for (size_t i = 0; i < count; ++i)
+            matches.push_back(m_Names[found[i].second]);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Protected methods //////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE void SubstringIndex::Trigrams(std::string_view str, std::vector<Trigram> &trigrams)
+    {
+        trigrams.clear();
+        for (size_t i = 0; i + 3 <= str.size(); ++i)
+            trigrams.push_back(Trigram(uint8_t(str[i])) << 16 | Trigram(uint8_t(str[i + 1])) << 8 | uint8_t(str[i + 2]));
+
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    }
+
+    CSYS_INLINE std::string SubstringIndex::Fold(std::string_view str)
+    {
+        std::string folded(str);
+        for (char &c : folded)
+            if (c >= 'A' && c <= 'Z')
+                c = char(c - 'A' + 'a');
+        return folded;
+    }
+}
@@ -7,16 +7,118 @@
 #pragma once
 
 #include "csys/command.h"
+#include "csys/variable.h"
+#include "csys/frozen_commands.h"
+#include "csys/command_queue.h"
+#include "csys/thread_pool.h"
 #include "csys/autocomplete.h"
 #include "csys/history.h"
+#include "csys/substring_index.h"
 #include "csys/item.h"
 #include "csys/script.h"
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace csys
 {
+    /*!
+     * \brief
+     *      Outcome of a command line ran in a batch:
+     *          - Success: Line ran without error.
+     *          - Empty: Line was only whitespace, nothing ran.
+     *          - Error: Line failed, error was logged.
+     */
+    enum class CommandStatus : unsigned char
+    {
+        SUCCESS = 0,
+        EMPTY,
+        ERROR
+    };
+
+    /*!
+     * \brief
+     *      Options of System::RunBatch
+     */
+    struct BatchOptions
+    {
+        bool m_Echo = false;             //!< Log every line as a command item (Like RunCommand does)
+        bool m_LineHistory = false;      //!< Record every line in history (Like RunCommand does)
+        std::string m_HistoryEntry;      //!< Single history entry recorded for the whole batch (None if empty)
+        size_t m_ReserveItems = 0;       //!< Log items to reserve up front, on top of the echoed lines
+        bool m_Suggestions = false;      //!< Suggest close names when a name isn't found (A fuzzy search per bad line)
+    };
+
+    /*!
+     * \brief
+     *      What the token under the cursor of a completed command line is:
+     *          - None: Nothing is completed there (Unknown command, quoted text, vector or non-boolean argument).
+     *          - Command: First token, a command name, set, get or help.
+     *          - Variable: Variable name after set or get.
+     *          - Help: Command name after help.
+     *          - Boolean: Boolean argument of a command or a set.
+     */
+    enum class CompletionContext : unsigned char
+    {
+        NONE = 0,
+        COMMAND,
+        VARIABLE,
+        HELP,
+        BOOLEAN
+    };
+
+    /*!
+     * \brief
+     *      Completions of a command line, as returned by System::Complete
+     */
+    struct LineCompletion
+    {
+        CompletionContext m_Context = CompletionContext::NONE;    //!< What is being completed
+        size_t m_Begin = 0;                                       //!< Start of the token the options replace
+        size_t m_End = 0;                                         //!< One past the end of the token the options replace
+        std::vector<std::string> m_Options;                       //!< Replacements, most used first
+    };
+
+    /*!
+     * \brief
+     *      Command line that has been resolved and parsed ahead of time by System::Compile, so it can be ran
+     *      repeatedly through System::Run without looking up the command or parsing its arguments again
+     */
+    class CSYS_API CommandHandle
+    {
+    public:
+
+        /*!
+         * \brief
+         *      Checks if the handle still refers to a registered command
+         * \return
+         *      Returns false if compilation failed or the command was unregistered since
+         */
+        [[nodiscard]] bool Valid() const;
+
+        /*!
+         * \brief
+         *      Get the command line this handle was compiled from
+         * \return
+         *      Command line string
+         */
+        [[nodiscard]] const std::string &Line() const;
+
+    protected:
+        friend class System;
+
+        std::string m_Line;                                  //!< Compiled command line
+        CommandVerb m_Verb = CommandVerb::NONE;              //!< Verb of the line (Set and get target a variable)
+        std::weak_ptr<CommandBase> m_Command;                //!< Resolved command (Expires when unregistered)
+        std::weak_ptr<VariableBase> m_Variable;              //!< Resolved variable (Expires when unregistered)
+        std::shared_ptr<const ArgumentPack> m_Arguments;     //!< Parsed arguments
+    };
+
     class CSYS_API System
     {
     public:
@@ -66,6 +168,163 @@ namespace csys
          */
         void RunCommand(const std::string &line);
 
+        /*!
+         * \brief
+         *      Run several command lines in order, without the per line logging and history of RunCommand
+         * \param lines
+         *      Command lines
+         * \param count
+         *      Number of command lines
+         * \param options
+         *      Echo, history and log reservation options
+         * \return
+         *      Status of every line, in order
+         *
+         * \note
+         *      Errors and command output are still logged
+         */
+        std::vector<CommandStatus> RunBatch(const std::string_view *lines, size_t count, const BatchOptions &options = BatchOptions());
+
+        /*!
+         * \brief
+         *      Run several command lines in order, without the per line logging and history of RunCommand
+         * \tparam Lines
+         *      Container of elements convertible to std::string_view
+         * \param lines
+         *      Command lines
+         * \param options
+         *      Echo, history and log reservation options
+         * \return
+         *      Status of every line, in order
+         *
+         * \note
+         *      Errors and command output are still logged
+         */
+        template<typename Lines>
+        std::vector<CommandStatus> RunBatch(const Lines &lines, const BatchOptions &options = BatchOptions())
+        {
+            std::vector<CommandStatus> status;
+            status.reserve(lines.size());
+
+            BeginBatch(lines.size(), options);
+            for (const auto &line : lines)
+                status.push_back(RunBatchLine(std::string_view(line), options));
+
+            return status;
+        }
+
+        /*!
+         * \brief
+         *      Create the queue used by System::Enqueue, dropping lines still queued
+         * \param capacity
+         *      Number of lines the queue can hold, rounded up to a power of two
+         * \param max_line
+         *      Size in bytes of the biggest line that can be queued
+         * \note
+         *      Must be called on the owning thread before other threads start enqueuing. Does nothing while the queue
+         *      is being drained
+         */
+        void CreateQueue(size_t capacity = 1024, size_t max_line = 256);
+
+        /*!
+         * \brief
+         *      Queue a command line to be ran by System::DrainQueue. Can be called from any thread
+         * \param line
+         *      Command line string
+         * \return
+         *      False if there is no queue, the queue is full or the line is longer than the queue allows
+         */
+        bool Enqueue(std::string_view line);
+
+        /*!
+         * \brief
+         *      Run queued command lines in the order they were queued, as RunCommand would
+         * \param max_items
+         *      Maximum number of lines to run
+         * \return
+         *      Number of lines taken from the queue (0 when called by a queued command)
+         * \note
+         *      Must only be called on the owning thread (Usually once per frame)
+         */
+        size_t DrainQueue(size_t max_items = SIZE_MAX);
+
+        /*!
+         * \brief
+         *      Parse given command line input and run it, without waiting for commands registered as async
+         * \param line
+         *      Command line string
+         * \return
+         *      Output of the command. Ready right away if parsing failed or the command is not async
+         * \note
+         *      The line is logged and recorded in history like with RunCommand. Output of async commands is logged by
+         *      System::PollAsync once they complete
+         */
+        std::future<Item> RunCommandAsync(const std::string &line);
+
+        /*!
+         * \brief
+         *      Log the output of async commands that completed since the last call
+         * \return
+         *      Number of items logged
+         * \note
+         *      Must only be called on the owning thread (Usually once per frame)
+         */
+        size_t PollAsync();
+
+        /*!
+         * \brief
+         *      Create the thread pool async commands run on, waiting for commands still running on the previous one
+         * \param threads
+         *      Number of worker threads
+         * \note
+         *      A pool with one thread per core is created on the first async command if none was created
+         */
+        void CreateThreadPool(size_t threads);
+
+        /*!
+         * \brief
+         *      Resolve and parse the given command line without running it
+         * \param line
+         *      Command line string
+         * \return
+         *      Handle to be ran with System::Run. Invalid if the command does not exist or parsing failed
+         *
+         * \note
+         *      Errors are logged the same way as with RunCommand
+         */
+        CommandHandle Compile(const std::string &line);
+
+        /*!
+         * \brief
+         *      Run a command line previously compiled with System::Compile
+         * \param handle
+         *      Compiled command line
+         *
+         * \note
+         *      The line is logged and recorded in history like with RunCommand. An error is logged if the handle is
+         *      no longer valid
+         */
+        void Run(const CommandHandle &handle);
+
+        /*!
+         * \brief
+         *      Index every registered command with a perfect hash table, used for dispatch until the next command or
+         *      variable (un)registration. The autocomplete trees are rebalanced
+         *
+         * \note
+         *      Meant for consoles whose command set doesn't change after startup. Modifying the container returned
+         *      by Commands() while frozen is not supported
+         */
+        void Freeze();
+
+        /*!
+         * \brief
+         *      Check if dispatch is using the frozen table
+         * \return
+         *      True if frozen
+         */
+        [[nodiscard]] bool Frozen() const;
+
         /*!
          * \brief
          *      Get console registered command autocomplete tree
@@ -82,6 +341,33 @@ namespace csys
          */
         AutoComplete &VarAutocomplete();
 
+        /*!
+         * \brief
+         *      Find registered commands, variables and scripts whose name contains the given text
+         * \param query
+         *      Text to look for, ASCII case is ignored
+         * \param limit
+         *      Maximum number of names
+         * \return
+         *      Names starting with query first, then names with a '_' separated token starting with query, then the
+         *      rest. Alphabetical (Ignoring case) within each group
+         */
+        std::vector<std::string> Search(std::string_view query, size_t limit = 10) const;
+
+        /*!
+         * \brief
+         *      Complete the token under the cursor of a command line, from what comes before it on the line
+         * \param line
+         *      Command line being typed
+         * \param cursor
+         *      Position of the cursor in line (Clamped to its size)
+         * \param max_results
+         *      Maximum number of options
+         * \return
+         *      Options for the token around the cursor, to replace the range [m_Begin, m_End) of line
+         */
+        LineCompletion Complete(std::string_view line, size_t cursor, size_t max_results = 10) const;
+
         /*!
          * \brief
          *      Get command history container
@@ -90,6 +376,31 @@ namespace csys
          */
         CommandHistory &History();
 
+        /*!
+         * \brief
+         *      Write command history and the hit counters of both autocomplete trees to a file, one record per line
+         *      (Line breaks and backslashes are escaped)
+         * \param path
+         *      Path of the file
+         * \return
+         *      False if the file couldn't be written
+         */
+        bool SaveHistory(const std::string &path);
+
+        /*!
+         * \brief
+         *      Append history and add hit counters read from a file written by SaveHistory. A file of plain command
+         *      lines is read as history, and hit counters are seeded from it
+         * \param path
+         *      Path of the file
+         * \return
+         *      False if the file couldn't be opened
+         *
+         * \note
+         *      Counters of names that aren't registered yet are dropped, so load after registering
+         */
+        bool LoadHistory(const std::string &path);
+
         /*!
          * \brief
          *      Get console items
@@ -123,9 +434,17 @@ namespace csys
          * \brief
          *      Get registered command container
          * \return
-         *      Commands container
+         *      Commands container, hashed by verb and name. Lookups can use a CommandKeyView
+         */
+        CommandMap &Commands();
+
+        /*!
+         * \brief
+         *      Get registered variable container
+         * \return
+         *      Variables container
          */
-        std::unordered_map<std::string, std::unique_ptr<CommandBase>> &Commands();
+        VariableMap &Variables();
 
         /*!
          * \brief
@@ -154,50 +473,33 @@ namespace csys
         template<typename Fn, typename ...Args>
         void RegisterCommand(const String &name, const String &description, Fn function, Args... args)
         {
-            // Check if function can be called with the given arguments and is not part of a class
-            static_assert(std::is_invocable_v<Fn, typename Args::ValueType...>, "Arguments specified do not match that of the function");
-            static_assert(!std::is_member_function_pointer_v<Fn>, "Non-static member functions are not allowed");
-
-            // Move to command
-            size_t name_index = 0;
-            auto range = name.NextPoi(name_index);
-
-            // Command already registered
-            if (m_Commands.find(name.m_String) != m_Commands.end())
-                throw csys::Exception("ERROR: Command already exists");
-
-            // Check if command has a name
-            else if (range.first == name.End())
-            {
-                Log(ERROR) << "Empty command name given" << csys::endl;
-                return;
-            }
-
-            // Get command name
-            std::string command_name = name.m_String.substr(range.first, range.second - range.first);
-
-            // Command contains more than one word
-            if (name.NextPoi(name_index).first != name.End())
-                throw csys::Exception("ERROR: Whitespace separated command names are forbidden");
-
-            // Register for autocomplete.
-            if (m_RegisterCommandSuggestion)
-            {
-                m_CommandSuggestionTree.Insert(command_name);
-                m_VariableSuggestionTree.Insert(command_name);
-            }
-
-            // Add commands to system
-            m_Commands[name.m_String] = std::make_unique<Command<Fn, Args...>>(name, description, function, args...);
-
-            // Make help command for command just added
-            auto help = [this, command_name]() {
-                Log(LOG) << m_Commands[command_name]->Help() << csys::endl;
-            };
+            RegisterCommandAux(false, name, description, std::move(function), args...);
+        }
 
-            m_Commands["help " + command_name] = std::make_unique<Command<decltype(help)>>("help " + command_name,
-                                                                                           "Displays help info about command " +
-                                                                                           command_name, help);
+        /*!
+         * \brief
+         *      Registers a command whose function runs on the system thread pool. Arguments are still parsed (and
+         *      errors logged) when the command is invoked, only the function call is deferred
+         * \tparam Fn
+         *      Decltype of the function to invoke when command is ran
+         * \tparam Args
+         *      List of arguments that match that of the argument list within the function Fn of type csys::Arg<T>
+         * \param name
+         *      Non-whitespace separating name of the command. Whitespace will be dropped
+         * \param description
+         *      Description describing what the command does
+         * \param function
+         *      A non-member function to run when command is called
+         * \param args
+         *      List of csys::Arg<T>s that matches that of the argument list of 'function'
+         * \note
+         *      The function runs on a worker thread, so it must not use the system. Calls can overlap, the function must
+         *      be thread safe. Return a csys::Item to log output
+         */
+        template<typename Fn, typename ...Args>
+        void RegisterCommand(Async, const String &name, const String &description, Fn function, Args... args)
+        {
+            RegisterCommandAux(true, name, description, std::move(function), args...);
         }
 
         /*!
@@ -218,19 +520,14 @@ namespace csys
          *      Param 'var' is assumed to have a valid life-time up until it is unregistered or the program ends
          */
         template<typename T, typename ...Types>
-        void RegisterVariable(const String &name, T &var, Arg<Types>... args)
+        void RegisterVariable(const String &name, T &var, Arg<Types>...)
         {
             static_assert(std::is_constructible_v<T, Types...>, "Type of var 'T' can not be constructed with types of 'Types'");
             static_assert(sizeof... (Types) != 0, "Empty variadic list");
 
-            // Register get command
-            auto var_name = RegisterVariableAux(name, var);
-
-            // Register set command
-            auto setter = [&var](Types... params){ var = T(params...); };
-            m_Commands["set " + var_name] = std::make_unique<Command<decltype(setter), Arg<Types>...>>("set " + var_name,
-                                                                                        "Sets the variable " + var_name,
-                                                                                        setter, args...);
+            // Register variable
+            using Setter = VariableConstructor<T, typename Arg<Types>::ValueType...>;
+            m_Variables[RegisterVariableAux(name)] = std::make_shared<Variable<T, Setter, Types...>>(var, Setter());
         }
 
         /*!
@@ -253,14 +550,9 @@ namespace csys
         template<typename T, typename ...Types>
         void RegisterVariable(const String &name, T &var, void(*setter)(T&, Types...))
         {
-            // Register get command
-            auto var_name = RegisterVariableAux(name, var);
-
-            // Register set command
-            auto setter_l = [&var, setter](Types... args){ setter(var, args...); };
-            m_Commands["set " + var_name] = std::make_unique<Command<decltype(setter_l), Arg<Types>...>>("set " + var_name,
-                                                                                        "Sets the variable " + var_name,
-                                                                                         setter_l, Arg<Types>("")...);
+            // Register variable
+            using Setter = void(*)(T&, Types...);
+            m_Variables[RegisterVariableAux(name)] = std::make_shared<Variable<T, Setter, Types...>>(var, setter);
         }
 
         /*!
@@ -298,48 +590,99 @@ namespace csys
         void UnregisterScript(const std::string &script_name);
 
     protected:
-        template<typename T>
-        std::string RegisterVariableAux(const String &name, T &var)
+        //!< Registers a command, see System::RegisterCommand
+        template<typename Fn, typename ...Args>
+        void RegisterCommandAux(bool async, const String &name, const String &description, Fn function, Args... args)
         {
-            // Disable.
-            m_RegisterCommandSuggestion = false;
+            // Check if function can be called with the given arguments and is not part of a class
+            static_assert(std::is_invocable_v<Fn, typename Args::ValueType...>, "Arguments specified do not match that of the function");
+            static_assert(!std::is_member_function_pointer_v<Fn>, "Non-static member functions are not allowed");
 
-            // Make sure only one word was passed in
+            // Command set changes.
+            m_FrozenCommands.Clear();
+
+            // Move to command
             size_t name_index = 0;
             auto range = name.NextPoi(name_index);
-            if (name.NextPoi(name_index).first != name.End())
-                throw csys::Exception("ERROR: Whitespace separated variable names are forbidden");
 
-            // Get variable name
-            std::string var_name = name.m_String.substr(range.first, range.second - range.first);
+            // Check if command has a name
+            if (range.first == name.End())
+            {
+                Log(ERROR) << "Empty command name given" << csys::endl;
+                return;
+            }
+
+            // Get command name
+            std::string command_name = name.m_String.substr(range.first, range.second - range.first);
 
-            // Get Command
-            const auto GetFunction = [this, &var]() {
-                m_ItemLog.log(LOG) << var << endl;
-            };
+            // Command already registered
+            if (m_Commands.find(CommandKeyView{CommandVerb::NONE, command_name}) != m_Commands.end())
+                CSYS_THROW(csys::Exception("ERROR: Command already exists"));
+
+            // Command contains more than one word
+            if (name.NextPoi(name_index).first != name.End())
+                CSYS_THROW(csys::Exception("ERROR: Whitespace separated command names are forbidden"));
 
-            // Register get command
-            m_Commands["get " + var_name] = std::make_unique<Command<decltype(GetFunction)>>("get " + var_name,
-                                                                                             "Gets the variable " +
-                                                                                             var_name, GetFunction);
+            // Register for autocomplete.
+            if (m_RegisterCommandSuggestion)
+            {
+                m_CommandSuggestionTree.Insert(command_name);
+                m_VariableSuggestionTree.Insert(command_name);
+                m_NameIndex.Insert(command_name);
+            }
 
-            // Enable again.
-            m_RegisterCommandSuggestion = true;
+            // Add commands to system
+            auto command = std::make_shared<Command<Fn, Args...>>(name, description, std::move(function), args...);
+            command->m_Async = async;
+            m_Commands[CommandKey{CommandVerb::NONE, command_name}] = std::move(command);
 
-            // Register variable
-            m_VariableSuggestionTree.Insert(var_name);
+            // Make help command for command just added
+            auto help = [this, command_name]() {
+                Log(LOG) << m_Commands[CommandKey{CommandVerb::NONE, command_name}]->Help() << csys::endl;
+            };
 
-            return var_name;
+            m_Commands[CommandKey{CommandVerb::HELP, command_name}] = std::make_shared<Command<decltype(help)>>("help " + command_name,
+                                                                                                               "Displays help info about command " +
+                                                                                                               command_name, help);
         }
 
-        void ParseCommandLine(const String &line);                                   //!< Parse command line and execute command
+        std::string RegisterVariableAux(const String &name);                         //!< Validate variable name and register it for autocomplete
+        CommandStatus ParseCommandLine(std::string_view line, bool history = true, bool suggest = true); //!< Parse command line and execute command
+        void BeginBatch(size_t count, const BatchOptions &options);                  //!< Reserve log and record history of a batch
+        CommandStatus RunBatchLine(std::string_view line, const BatchOptions &options); //!< Run command line of a batch
+        bool ParseCommandKey(std::string_view line, size_t &index, CommandKeyView &key); //!< Read verb and name of non-empty line, logs on error
+        CommandMap::iterator FindCommand(const CommandKeyView &key, bool suggest = true); //!< Find command, logs if not found
+        VariableMap::iterator FindVariable(std::string_view name, bool suggest = true); //!< Find variable, logs if not found
+        void LogVariableError(const CommandKeyView &key, const Item &error);         //!< Log error of a variable set or get
+        void LogNotFound(std::string_view name, const AutoComplete *tree);            //!< Log name not found, with close matches in tree if any
+        void RecordHit(const CommandKeyView &key);                                   //!< Count a successful dispatch for ranked suggestions
+        void SeedHits(std::string_view line);                                        //!< Count the names of a history line, without logging
+        void Execute(const CommandHandle &handle, const std::shared_ptr<CommandBase> &command,
+                     const std::shared_ptr<VariableBase> &variable,
+                     const std::shared_ptr<std::promise<Item>> &promise);            //!< Run resolved handle, fulfilling promise if any
+        void Submit(const std::shared_ptr<CommandBase> &command, std::shared_ptr<const ArgumentPack> arguments,
+                    std::shared_ptr<std::promise<Item>> promise, std::string_view line); //!< Run command on the thread pool
+
+        //!< Output of async commands waiting to be logged.
+        struct AsyncResults
+        {
+            std::mutex m_Mutex;            //!< Guards m_Items
+            std::vector<Item> m_Items;     //!< Completed output
+        };
 
-        std::unordered_map<std::string, std::unique_ptr<CommandBase>> m_Commands;    //!< Registered command container
+        CommandMap m_Commands;                                                       //!< Registered command container
+        VariableMap m_Variables;                                                     //!< Registered variable container
+        FrozenCommands m_FrozenCommands;                                             //!< Perfect hash index of m_Commands (Empty if not frozen)
         AutoComplete m_CommandSuggestionTree;                                        //!< Autocomplete Ternary Search Tree for commands
         AutoComplete m_VariableSuggestionTree;                                       //!< Autocomplete Ternary Search Tree for registered variables
+        SubstringIndex m_NameIndex;                                                  //!< Substring index of the names in m_VariableSuggestionTree
         CommandHistory m_CommandHistory;                                             //!< History of executed commands
         ItemLog m_ItemLog;                                                           //!< Console Items (Logging)
         std::unordered_map<std::string, std::unique_ptr<Script>> m_Scripts;          //!< Scripts
+        std::unique_ptr<CommandQueue> m_Queue;                                       //!< Lines queued from other threads (Null until created)
+        bool m_Draining = false;                                                     //!< Flag set while DrainQueue runs queued lines
+        std::shared_ptr<AsyncResults> m_AsyncResults;                                //!< Output of async commands (Shared with running tasks)
+        std::unique_ptr<ThreadPool> m_ThreadPool;                                    //!< Workers of async commands (Null until created)
         bool m_RegisterCommandSuggestion = true;                                     //!< Flag that determines if commands will be registered for autocomplete.
     };
 }
@@ -9,6 +9,10 @@
 
 #endif
 
+#include <cctype>
+#include <charconv>
+#include <fstream>
+
 namespace csys
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -21,9 +25,37 @@ namespace csys
     static const std::string_view s_Help = "help";
     static const std::string_view s_ErrorNoVar = "No variable provided";
     static const std::string_view s_ErrorSetGetNotFound = "Command doesn't exist and/or variable is not registered";
+    static const std::string_view s_ErrorInvalidHandle = "Compiled command is no longer registered";
+
+    // History file records.
+    static const std::string_view s_HistoryHeader = "csys_history 1";
+    static const std::string_view s_HistoryCommand = "command";
+    static const std::string_view s_HistoryVariable = "variable";
+    static const std::string_view s_HistoryLine = "line";
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Command Handle /////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE bool CommandHandle::Valid() const
+    {
+        if (m_Verb == CommandVerb::SET || m_Verb == CommandVerb::GET)
+            return m_Arguments && !m_Variable.expired();
+        return m_Arguments && !m_Command.expired();
+    }
+
+    CSYS_INLINE const std::string &CommandHandle::Line() const { return m_Line; }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // System /////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
 
     CSYS_INLINE System::System()
     {
+        // Rank suggestions by use.
+        m_CommandSuggestionTree.EnableHits();
+        m_VariableSuggestionTree.EnableHits();
+
         // Register help command.
         RegisterCommand(s_Help.data(), "Display commands information", [this]()
         {
@@ -34,12 +66,12 @@ namespace csys
 
             for (const auto &tuple : Commands())
             {
-                // Filter set and get.
-                if (tuple.first.size() >= 5 && (tuple.first[3] == ' ' || tuple.first[4] == ' '))
+                // Filter set, get and help.
+                if (tuple.first.m_Verb != CommandVerb::NONE)
                     continue;
 
                 // Skip help command.
-                if (tuple.first.size() == 4 && (tuple.first == "help"))
+                if (tuple.first.m_Name == s_Help)
                     continue;
 
                 // Print the rest of commands
@@ -54,6 +86,7 @@ namespace csys
 
     CSYS_INLINE System::System(const System &rhs) : m_CommandSuggestionTree(rhs.m_CommandSuggestionTree),
                                                     m_VariableSuggestionTree(rhs.m_VariableSuggestionTree),
+                                                    m_NameIndex(rhs.m_NameIndex),
                                                     m_CommandHistory(rhs.m_CommandHistory),
                                                     m_ItemLog(rhs.m_ItemLog),
                                                     m_RegisterCommandSuggestion(rhs.m_RegisterCommandSuggestion)
@@ -61,14 +94,28 @@ namespace csys
         // Copy commands.
         for (const auto &pair : rhs.m_Commands)
         {
-            m_Commands[pair.first] = std::unique_ptr<CommandBase>(pair.second->Clone());
+            m_Commands[pair.first] = std::shared_ptr<CommandBase>(pair.second->Clone());
+        }
+
+        // Copy variables.
+        for (const auto &pair : rhs.m_Variables)
+        {
+            m_Variables[pair.first] = std::shared_ptr<VariableBase>(pair.second->Clone());
         }
 
+        // Index copied commands.
+        if (rhs.Frozen())
+            Freeze();
+
         // Copy scripts.
         for (const auto &pair: rhs.m_Scripts)
         {
             m_Scripts[pair.first] = std::make_unique<Script>(*pair.second);
         }
+
+        // Queued lines are not copied, only the queue size.
+        if (rhs.m_Queue)
+            CreateQueue(rhs.m_Queue->Capacity(), rhs.m_Queue->MaxLine());
     }
 
     CSYS_INLINE System &System::operator=(const System &rhs)
@@ -77,14 +124,26 @@ namespace csys
             return *this;
 
         // Copy commands.
+        m_FrozenCommands.Clear();
         for (const auto &pair : rhs.m_Commands)
         {
-            m_Commands[pair.first] = std::unique_ptr<CommandBase>(pair.second->Clone());
+            m_Commands[pair.first] = std::shared_ptr<CommandBase>(pair.second->Clone());
         }
 
+        // Copy variables.
+        for (const auto &pair : rhs.m_Variables)
+        {
+            m_Variables[pair.first] = std::shared_ptr<VariableBase>(pair.second->Clone());
+        }
+
+        // Index copied commands.
+        if (rhs.Frozen())
+            Freeze();
+
         // Other data.
         m_CommandSuggestionTree = rhs.m_CommandSuggestionTree;
         m_VariableSuggestionTree = rhs.m_VariableSuggestionTree;
+        m_NameIndex = rhs.m_NameIndex;
         m_CommandHistory = rhs.m_CommandHistory;
         m_ItemLog = rhs.m_ItemLog;
 
@@ -94,6 +153,14 @@ namespace csys
             m_Scripts[pair.first] = std::make_unique<Script>(*pair.second);
         }
 
+        // Queued lines are not copied, only the queue size (The queue being drained is kept).
+        if (!m_Draining)
+        {
+            m_Queue.reset();
+            if (rhs.m_Queue)
+                CreateQueue(rhs.m_Queue->Capacity(), rhs.m_Queue->MaxLine());
+        }
+
         // Rest of data.
         m_RegisterCommandSuggestion = rhs.m_RegisterCommandSuggestion;
 
@@ -113,6 +180,222 @@ namespace csys
         ParseCommandLine(line);
     }
 
+    CSYS_INLINE std::vector<CommandStatus> System::RunBatch(const std::string_view *lines, size_t count, const BatchOptions &options)
+    {
+        std::vector<CommandStatus> status;
+        status.reserve(count);
+
+        BeginBatch(count, options);
+        for (size_t i = 0; i < count; ++i)
+            status.push_back(RunBatchLine(lines[i], options));
+
+        return status;
+    }
+
+    CSYS_INLINE void System::CreateQueue(size_t capacity, size_t max_line)
+    {
+        // The queue being drained stays alive.
+        if (m_Draining)
+            return;
+
+        m_Queue = std::make_unique<CommandQueue>(capacity, max_line);
+    }
+
+    CSYS_INLINE bool System::Enqueue(std::string_view line)
+    {
+        return m_Queue && m_Queue->Push(line);
+    }
+
+    CSYS_INLINE size_t System::DrainQueue(size_t max_items)
+    {
+        // Queued commands can't drain the queue again.
+        if (!m_Queue || m_Draining)
+            return 0;
+
+        // Flag is cleared even if a command throws.
+        struct DrainGuard
+        {
+            bool &m_Flag;
+            ~DrainGuard() { m_Flag = false; }
+        } guard{m_Draining};
+        m_Draining = true;
+
+        // Run lines the same way RunCommand does.
+        size_t drained = 0;
+        while (drained < max_items && m_Queue->Pop([this](std::string_view line)
+        {
+            if (line.empty())
+                return;
+
+            Log(csys::ItemType::COMMAND) << line << csys::endl;
+            ParseCommandLine(line);
+        }))
+            ++drained;
+
+        return drained;
+    }
+
+    CSYS_INLINE CommandHandle System::Compile(const std::string &line)
+    {
+        CommandHandle handle;
+        handle.m_Line = line;
+
+        // Just whitespace was passed in.
+        size_t line_index = 0;
+        if (String::NextPoi(line, line_index).first == line.size() + 1)
+            return handle;
+
+        // Get verb and name.
+        line_index = 0;
+        CommandKeyView key{};
+        if (!ParseCommandKey(line, line_index, key))
+            return handle;
+
+        // Parse arguments once.
+        std::string_view arguments = std::string_view(line).substr(line_index);
+        std::unique_ptr<ArgumentPack> pack;
+        Item cmd_out(NONE);
+
+        // Variable set or get.
+        if (key.m_Verb == CommandVerb::SET || key.m_Verb == CommandVerb::GET)
+        {
+            auto variable = FindVariable(key.m_Name);
+            if (variable == m_Variables.end())
+                return handle;
+
+            if (key.m_Verb == CommandVerb::SET)
+                cmd_out = variable->second->Compile(arguments, pack);
+            else
+            {
+                // Getters take no arguments.
+                size_t start = 0;
+                if (auto error = Arg<NULL_ARGUMENT>().TryParse(arguments, start))
+                    cmd_out = Item(ERROR) << error.Message(arguments);
+                else
+                    pack = std::make_unique<ArgumentPack>();
+            }
+
+            if (cmd_out.m_Type != NONE)
+            {
+                LogVariableError(key, cmd_out);
+                return handle;
+            }
+
+            handle.m_Variable = variable->second;
+        }
+        // Command.
+        else
+        {
+            auto command = FindCommand(key);
+            if (command == m_Commands.end())
+                return handle;
+
+            cmd_out = command->second->Compile(arguments, pack);
+            if (cmd_out.m_Type != NONE)
+            {
+                m_ItemLog.Items().emplace_back(cmd_out);
+                return handle;
+            }
+
+            handle.m_Command = command->second;
+        }
+
+        handle.m_Verb = key.m_Verb;
+        handle.m_Arguments = std::move(pack);
+        return handle;
+    }
+
+    CSYS_INLINE void System::Run(const CommandHandle &handle)
+    {
+        // Keep target alive while running, even if it unregisters itself.
+        bool is_variable = handle.m_Verb == CommandVerb::SET || handle.m_Verb == CommandVerb::GET;
+        auto command = handle.m_Command.lock();
+        auto variable = handle.m_Variable.lock();
+        if (!handle.m_Arguments || (is_variable ? !variable : !command))
+        {
+            Log(ERROR) << s_ErrorInvalidHandle << ": " << handle.m_Line << endl;
+            return;
+        }
+
+        // Log command.
+        Log(csys::ItemType::COMMAND) << handle.m_Line << csys::endl;
+        m_CommandHistory.PushBack(handle.m_Line);
+
+        // Execute command.
+        Execute(handle, command, variable, nullptr);
+    }
+
+    CSYS_INLINE std::future<Item> System::RunCommandAsync(const std::string &line)
+    {
+        auto promise = std::make_shared<std::promise<Item>>();
+        auto future = promise->get_future();
+
+        // Error checking.
+        if (line.empty())
+        {
+            promise->set_value(Item(NONE));
+            return future;
+        }
+
+        // Log command.
+        Log(csys::ItemType::COMMAND) << line << csys::endl;
+
+        // Parse now, so errors are reported right away.
+        size_t items = m_ItemLog.Items().size();
+        CommandHandle handle = Compile(line);
+        if (!handle.Valid())
+        {
+            promise->set_value(m_ItemLog.Items().size() > items ? m_ItemLog.Items().back() : Item(NONE));
+            return future;
+        }
+
+        // Push to history.
+        m_CommandHistory.PushBack(line);
+
+        // Execute command.
+        Execute(handle, handle.m_Command.lock(), handle.m_Variable.lock(), promise);
+        return future;
+    }
+
+    CSYS_INLINE size_t System::PollAsync()
+    {
+        if (!m_AsyncResults)
+            return 0;
+
+        // Take completed output.
+        std::vector<Item> items;
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncResults->m_Mutex);
+            items.swap(m_AsyncResults->m_Items);
+        }
+
+        // Log output.
+        for (auto &item : items)
+            m_ItemLog.Items().emplace_back(std::move(item));
+
+        return items.size();
+    }
+
+    CSYS_INLINE void System::CreateThreadPool(size_t threads)
+    {
+        m_ThreadPool.reset();
+        m_ThreadPool = std::make_unique<ThreadPool>(threads);
+    }
+
+    CSYS_INLINE void System::Freeze()
+    {
+        m_FrozenCommands.Build(m_Commands, m_Variables);
+
+        // Names were inserted one at a time, often sorted.
+        m_CommandSuggestionTree.Rebalance();
+        m_VariableSuggestionTree.Rebalance();
+    }
+
+    CSYS_INLINE bool System::Frozen() const
+    {
+        return !m_FrozenCommands.Empty();
+    }
+
     CSYS_INLINE void System::RunScript(const std::string &script_name)
     {
         // Attempt to find script.
@@ -129,17 +412,8 @@ namespace csys
         m_ItemLog.log(INFO) << "Running \"" << script_name << "\"" << csys::endl;
 
         // Load if script is empty.
-        if (script_pair->second->Data().empty())
-        {
-            try
-            {
-                script_pair->second->Load();
-            }
-            catch (csys::Exception &e)
-            {
-                Log(ERROR) << e.what() << csys::endl;
-            }
-        }
+        if (script_pair->second->Data().empty() && !script_pair->second->TryLoad())
+            m_ItemLog.log(ERROR) << "Failed to load script \"" << script_name << "\"" << csys::endl;
 
         // Run script.
         for (const auto &cmd : script_pair->second->Data())
@@ -159,8 +433,9 @@ namespace csys
         {
             m_Scripts[name] = std::make_unique<Script>(path, true);
             m_VariableSuggestionTree.Insert(name);
+            m_NameIndex.Insert(name);
         } else
-            throw csys::Exception("ERROR: Script \'" + name + "\' already registered");
+            CSYS_THROW(csys::Exception("ERROR: Script \'" + name + "\' already registered"));
     }
 
     CSYS_INLINE void System::UnregisterCommand(const std::string &cmd_name)
@@ -169,14 +444,16 @@ namespace csys
         if (cmd_name.empty()) return;
 
         // Get command.
-        auto command_it = m_Commands.find(cmd_name);
-        auto help_command_it = m_Commands.find("help " + cmd_name);
+        auto command_it = m_Commands.find(CommandKeyView{CommandVerb::NONE, cmd_name});
+        auto help_command_it = m_Commands.find(CommandKeyView{CommandVerb::HELP, cmd_name});
 
         // Erase if found.
         if (command_it != m_Commands.end() && help_command_it != m_Commands.end())
         {
+            m_FrozenCommands.Clear();
             m_CommandSuggestionTree.Remove(cmd_name);
             m_VariableSuggestionTree.Remove(cmd_name);
+            m_NameIndex.Remove(cmd_name);
 
             m_Commands.erase(command_it);
             m_Commands.erase(help_command_it);
@@ -188,16 +465,16 @@ namespace csys
         // Exit if non existent.
         if (var_name.empty()) return;
 
-        // Get command.
-        auto s_it = m_Commands.find("set " + var_name);
-        auto g_it = m_Commands.find("get " + var_name);
+        // Get variable.
+        auto it = m_Variables.find(var_name);
 
         // Erase if found.
-        if (s_it != m_Commands.end() && g_it != m_Commands.end())
+        if (it != m_Variables.end())
         {
+            m_FrozenCommands.Clear();
             m_VariableSuggestionTree.Remove(var_name);
-            m_Commands.erase(s_it);
-            m_Commands.erase(g_it);
+            m_NameIndex.Remove(var_name);
+            m_Variables.erase(it);
         }
     }
 
@@ -213,10 +490,139 @@ namespace csys
         if (it != m_Scripts.end())
         {
             m_VariableSuggestionTree.Remove(script_name);
+            m_NameIndex.Remove(script_name);
             m_Scripts.erase(it);
         }
     }
 
+    CSYS_INLINE std::vector<std::string> System::Search(std::string_view query, size_t limit) const
+    {
+        std::vector<std::string> names;
+        m_NameIndex.Search(query, limit, names);
+        return names;
+    }
+
+    CSYS_INLINE LineCompletion System::Complete(std::string_view line, size_t cursor, size_t max_results) const
+    {
+        LineCompletion completion;
+        std::string_view before = line.substr(0, std::min(cursor, line.size()));
+
+        // Tokenize up to the cursor once, quoted strings and vectors are a single token.
+        std::string_view first, second;
+        size_t finished = 0, begin = before.size(), depth = 0;
+        bool in_token = false, quoted = false;
+        for (size_t i = 0; i < before.size(); ++i)
+        {
+            bool space = Scan::IsSpace(before[i]);
+            if (!in_token)
+            {
+                if (space) continue;
+                in_token = true;
+                begin = i;
+            }
+
+            if (Reserved::IsEscaping(before, i))
+                ++i;
+            else if (before[i] == '"')
+                quoted = !quoted;
+            else if (quoted)
+                continue;
+            else if (before[i] == '[')
+                ++depth;
+            else if (before[i] == ']' && depth > 0)
+                --depth;
+            else if (space && depth == 0)
+            {
+                if (finished == 0)
+                    first = before.substr(begin, i - begin);
+                else if (finished == 1)
+                    second = before.substr(begin, i - begin);
+                ++finished;
+                in_token = false;
+                begin = before.size();
+            }
+        }
+
+        // Token around the cursor.
+        completion.m_Begin = begin;
+        completion.m_End = Scan::FindSpace(line, before.size());
+        if (quoted || depth > 0)
+            return completion;
+        std::string_view prefix = before.substr(begin);
+
+        // Most used names of a tree that keep accepts, asking for more until enough are kept or the tree runs out.
+        auto ranked = [&](const AutoComplete &tree, auto keep)
+        {
+            for (size_t wanted = max_results;; wanted *= 2)
+            {
+                std::vector<std::string> names;
+                tree.RankedSuggestions(prefix, wanted, names);
+                completion.m_Options.clear();
+                for (auto &name : names)
+                    if (completion.m_Options.size() < max_results && keep(name))
+                        completion.m_Options.push_back(std::move(name));
+                if (completion.m_Options.size() == max_results || names.size() < wanted)
+                    return;
+            }
+        };
+
+        // Boolean literals, case is ignored like the parser does.
+        auto booleans = [&](bool is_bool)
+        {
+            if (!is_bool) return;
+            completion.m_Context = CompletionContext::BOOLEAN;
+            for (std::string_view literal : {std::string_view("true"), std::string_view("false")})
+            {
+                bool match = prefix.size() <= literal.size() && completion.m_Options.size() < max_results;
+                for (size_t i = 0; match && i < prefix.size(); ++i)
+                    match = std::tolower(static_cast<unsigned char>(prefix[i])) == literal[i];
+                if (match)
+                    completion.m_Options.emplace_back(literal);
+            }
+        };
+
+        // Command name.
+        if (finished == 0)
+        {
+            completion.m_Context = CompletionContext::COMMAND;
+            m_CommandSuggestionTree.RankedSuggestions(prefix, max_results, completion.m_Options);
+        }
+            // Variable name, or argument of a set.
+        else if (first == s_Set || first == s_Get)
+        {
+            if (finished == 1)
+            {
+                completion.m_Context = CompletionContext::VARIABLE;
+                ranked(m_VariableSuggestionTree, [this](const std::string &name)
+                { return m_Variables.find(name) != m_Variables.end(); });
+            } else if (first == s_Set)
+            {
+                auto variable = m_Variables.find(second);
+                if (variable != m_Variables.end())
+                    booleans(variable->second->BoolArgument(finished - 2));
+            }
+        }
+            // Command with help info.
+        else if (first == s_Help)
+        {
+            if (finished == 1)
+            {
+                completion.m_Context = CompletionContext::HELP;
+                ranked(m_CommandSuggestionTree, [this](const std::string &name)
+                { return m_Commands.find(CommandKeyView{CommandVerb::HELP, name}) != m_Commands.end(); });
+            }
+        }
+            // Argument of a command.
+        else
+        {
+            auto command = m_Commands.find(CommandKeyView{CommandVerb::NONE, first});
+            if (command != m_Commands.end())
+                booleans(command->second->BoolArgument(finished - 1));
+        }
+
+        return completion;
+    }
+
     // Getters ////////////////////////////////////////////////////////////////
 
     CSYS_INLINE AutoComplete &System::CmdAutocomplete() { return m_CommandSuggestionTree; }
@@ -225,11 +631,134 @@ namespace csys
 
     CSYS_INLINE CommandHistory &System::History() { return m_CommandHistory; }
 
+    CSYS_INLINE bool System::SaveHistory(const std::string &path)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+            return false;
+
+        // Records are one line each, so line breaks and backslashes in text are escaped.
+        auto write = [&file](std::string_view text)
+        {
+            for (char c : text)
+            {
+                if (c == '\\') file << "\\\\";
+                else if (c == '\n') file << "\\n";
+                else if (c == '\r') file << "\\r";
+                else file << c;
+            }
+            file << '\n';
+        };
+
+        // Counters of used names, one record each.
+        file << s_HistoryHeader << '\n';
+        auto save_hits = [&file, &write](const AutoComplete &tree, std::string_view record)
+        {
+            tree.Suggestions("", SIZE_MAX, [&file, &write, &tree, record](std::string_view word)
+            {
+                if (uint32_t hits = tree.Hits(word))
+                {
+                    file << record << ' ' << hits << ' ';
+                    write(word);
+                }
+            });
+        };
+        save_hits(m_CommandSuggestionTree, s_HistoryCommand);
+        save_hits(m_VariableSuggestionTree, s_HistoryVariable);
+
+        // Lines, oldest first.
+        size_t size = m_CommandHistory.Size();
+        for (size_t i = 0; i < size; ++i)
+        {
+            file << s_HistoryLine << ' ';
+            write(m_CommandHistory[(m_CommandHistory.GetOldIndex() + i) % size]);
+        }
+
+        return bool(file);
+    }
+
+    CSYS_INLINE bool System::LoadHistory(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+
+        // Plain command lines.
+        std::string line;
+        if (!std::getline(file, line) || line != s_HistoryHeader)
+        {
+            file.clear();
+            file.seekg(0);
+            while (std::getline(file, line))
+            {
+                // Skip whitespace only lines.
+                size_t index = 0;
+                if (String::NextPoi(line, index).first == line.size() + 1)
+                    continue;
+
+                m_CommandHistory.PushBack(line);
+                SeedHits(line);
+            }
+            return true;
+        }
+
+        // Undo the escaping of SaveHistory.
+        auto read = [](std::string_view text)
+        {
+            std::string result;
+            result.reserve(text.size());
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                if (text[i] != '\\' || i + 1 == text.size())
+                {
+                    result += text[i];
+                    continue;
+                }
+                char c = text[++i];
+                result += c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+            }
+            return result;
+        };
+
+        while (std::getline(file, line))
+        {
+            // Record type, and the rest of the line.
+            std::string_view record = line;
+            size_t space = record.find(' ');
+            if (space == std::string_view::npos)
+                continue;
+            std::string_view data = record.substr(space + 1);
+            record = record.substr(0, space);
+
+            if (record == s_HistoryLine)
+            {
+                m_CommandHistory.PushBack(read(data));
+                continue;
+            }
+
+            // Counter followed by its name.
+            uint32_t hits = 0;
+            auto result = std::from_chars(data.data(), data.data() + data.size(), hits);
+            if (result.ec != std::errc() || result.ptr == data.data() + data.size())
+                continue;
+            std::string name = read(data.substr(size_t(result.ptr - data.data()) + 1));
+
+            if (record == s_HistoryCommand)
+                m_CommandSuggestionTree.Hit(name, hits);
+            else if (record == s_HistoryVariable)
+                m_VariableSuggestionTree.Hit(name, hits);
+        }
+
+        return true;
+    }
+
     CSYS_INLINE std::vector<Item> &System::Items() { return m_ItemLog.Items(); }
 
     CSYS_INLINE ItemLog &System::Log(ItemType type) { return m_ItemLog.log(type); }
 
-    CSYS_INLINE std::unordered_map<std::string, std::unique_ptr<CommandBase>> &System::Commands() { return m_Commands; }
+    CSYS_INLINE CommandMap &System::Commands() { return m_Commands; }
+
+    CSYS_INLINE VariableMap &System::Variables() { return m_Variables; }
 
     CSYS_INLINE std::unordered_map<std::string, std::unique_ptr<Script>> &System::Scripts() { return m_Scripts; }
 
@@ -237,64 +766,315 @@ namespace csys
     // Private methods ////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 
-    CSYS_INLINE void System::ParseCommandLine(const String &line)
+    CSYS_INLINE std::string System::RegisterVariableAux(const String &name)
+    {
+        // Variable set changes.
+        m_FrozenCommands.Clear();
+
+        // Make sure only one word was passed in
+        size_t name_index = 0;
+        auto range = name.NextPoi(name_index);
+        if (name.NextPoi(name_index).first != name.End())
+            CSYS_THROW(csys::Exception("ERROR: Whitespace separated variable names are forbidden"));
+
+        // Get variable name
+        std::string var_name = name.m_String.substr(range.first, range.second - range.first);
+
+        // Register variable
+        m_VariableSuggestionTree.Insert(var_name);
+        m_NameIndex.Insert(var_name);
+
+        return var_name;
+    }
+
+    CSYS_INLINE CommandStatus System::ParseCommandLine(std::string_view line, bool history, bool suggest)
     {
         // Get first non-whitespace char.
         size_t line_index = 0;
-        std::pair<size_t, size_t> range = line.NextPoi(line_index);
-
-        // Just whitespace was passed in. Don't log as command.
-        if (range.first == line.End())
-            return;
+        if (String::NextPoi(line, line_index).first == line.size() + 1)
+            return CommandStatus::EMPTY; // Just whitespace was passed in. Don't log as command.
 
         // Push to history.
-        m_CommandHistory.PushBack(line.m_String);
+        if (history)
+            m_CommandHistory.PushBack(line);
 
+        // Get verb and name.
+        line_index = 0;
+        CommandKeyView key{};
+        if (!ParseCommandKey(line, line_index, key))
+            return CommandStatus::ERROR;
+
+        // The rest of the line are arguments.
+        std::string_view arguments = line.substr(line_index);
+
+        // Variable set or get.
+        if (key.m_Verb == CommandVerb::SET || key.m_Verb == CommandVerb::GET)
+        {
+            auto variable = FindVariable(key.m_Name, suggest);
+            if (variable == m_Variables.end())
+                return CommandStatus::ERROR;
+
+            auto var_out = key.m_Verb == CommandVerb::SET ? variable->second->Set(arguments)
+                                                          : variable->second->Get(arguments, m_ItemLog);
+            if (var_out.m_Type == NONE)
+            {
+                RecordHit(key);
+                return CommandStatus::SUCCESS;
+            }
+
+            LogVariableError(key, var_out);
+            return CommandStatus::ERROR;
+        }
+
+        // Get runnable command
+        auto command = FindCommand(key, suggest);
+        if (command == m_Commands.end())
+            return CommandStatus::ERROR;
+
+        // Async command, parse here and run on the thread pool.
+        if (command->second->m_Async)
+        {
+            std::unique_ptr<ArgumentPack> pack;
+            auto parse_out = command->second->Compile(arguments, pack);
+            if (parse_out.m_Type != NONE)
+            {
+                m_ItemLog.Items().emplace_back(parse_out);
+                return CommandStatus::ERROR;
+            }
+
+            Submit(command->second, std::move(pack), nullptr, line);
+            RecordHit(key);
+            return CommandStatus::SUCCESS;
+        }
+
+        // Execute command.
+        auto cmd_out = (*command->second)(arguments);
+        if (cmd_out.m_Type == NONE)
+        {
+            RecordHit(key);
+            return CommandStatus::SUCCESS;
+        }
+
+        // Log output.
+        m_ItemLog.Items().emplace_back(cmd_out);
+        if (cmd_out.m_Type == ERROR)
+            return CommandStatus::ERROR;
+
+        RecordHit(key);
+        return CommandStatus::SUCCESS;
+    }
+
+    CSYS_INLINE void System::BeginBatch(size_t count, const BatchOptions &options)
+    {
+        // Reserve log up front.
+        auto &items = m_ItemLog.Items();
+        items.reserve(items.size() + (options.m_Echo ? count : 0) + options.m_ReserveItems);
+
+        // One entry for the whole batch.
+        if (!options.m_HistoryEntry.empty())
+            m_CommandHistory.PushBack(options.m_HistoryEntry);
+    }
+
+    CSYS_INLINE CommandStatus System::RunBatchLine(std::string_view line, const BatchOptions &options)
+    {
+        // Error checking.
+        if (line.empty())
+            return CommandStatus::EMPTY;
+
+        // Log command.
+        if (options.m_Echo)
+            Log(csys::ItemType::COMMAND) << line << csys::endl;
+
+        // Parse command line.
+        return ParseCommandLine(line, options.m_LineHistory, options.m_Suggestions);
+    }
+
+    CSYS_INLINE bool System::ParseCommandKey(std::string_view line, size_t &index, CommandKeyView &key)
+    {
         // Get name of command.
-        std::string command_name = line.m_String.substr(range.first, range.second - range.first);
+        const size_t end = line.size() + 1;
+        std::pair<size_t, size_t> range = String::NextPoi(line, index);
+        key = CommandKeyView{CommandVerb::NONE, line.substr(range.first, range.second - range.first)};
 
         // Set or get
-        bool is_cmd_set = command_name == s_Set;
-        bool is_cmd_get = command_name == s_Get;
-        bool is_cmd_help = !(is_cmd_set || is_cmd_get) ? command_name == s_Help : false;
+        if (key.m_Name == s_Set)
+            key.m_Verb = CommandVerb::SET;
+        else if (key.m_Name == s_Get)
+            key.m_Verb = CommandVerb::GET;
 
         // Edge case for if user is just runs "help" command
-        if (is_cmd_help)
+        if (key.m_Name == s_Help)
         {
-            range = line.NextPoi(line_index);
-            if (range.first != line.End())
-                command_name += " " + line.m_String.substr(range.first, range.second - range.first);
+            range = String::NextPoi(line, index);
+            if (range.first != end)
+                key = CommandKeyView{CommandVerb::HELP, line.substr(range.first, range.second - range.first)};
         }
 
             // Its a set or get command
-        else if (is_cmd_set || is_cmd_get)
+        else if (key.m_Verb != CommandVerb::NONE)
         {
             // Try to get variable name
-            if ((range = line.NextPoi(line_index)).first == line.End())
+            if ((range = String::NextPoi(line, index)).first == end)
             {
                 Log(ERROR) << s_ErrorNoVar << endl;
-                return;
+                return false;
             } else
-                // Append variable name.
-                command_name += " " + line.m_String.substr(range.first, range.second - range.first);
+                key.m_Name = line.substr(range.first, range.second - range.first);
         }
 
+        return true;
+    }
+
+    CSYS_INLINE CommandMap::iterator System::FindCommand(const CommandKeyView &key, bool suggest)
+    {
         // Get runnable command
-        auto command = m_Commands.find(command_name);
+        auto command = m_FrozenCommands.Empty() ? m_Commands.find(key) : m_FrozenCommands.Find(key, m_Commands.end());
         if (command == m_Commands.end())
-            Log(ERROR) << s_ErrorSetGetNotFound << endl;
-            // Run the command
+            LogNotFound(key.m_Name, suggest ? &m_CommandSuggestionTree : nullptr);
+
+        return command;
+    }
+
+    CSYS_INLINE VariableMap::iterator System::FindVariable(std::string_view name, bool suggest)
+    {
+        // Get registered variable
+        auto variable = m_FrozenCommands.Empty() ? m_Variables.find(name) : m_FrozenCommands.Find(name, m_Variables.end());
+        if (variable == m_Variables.end())
+            LogNotFound(name, suggest ? &m_VariableSuggestionTree : nullptr);
+
+        return variable;
+    }
+
+    CSYS_INLINE void System::LogNotFound(std::string_view name, const AutoComplete *tree)
+    {
+        // Close matches, allowing one typo per four characters. Searches past two typos cost milliseconds on big trees.
+        std::vector<std::string> matches;
+        if (tree)
+            tree->FuzzySuggestions(name, std::min<size_t>(name.size() / 4 + 1, 2), 3, matches);
+
+        auto &log = Log(ERROR) << s_ErrorSetGetNotFound;
+        for (size_t i = 0; i < matches.size(); ++i)
+            log << (i == 0 ? ", did you mean \"" : "\", \"") << matches[i];
+        if (!matches.empty())
+            log << "\"?";
+        log << endl;
+    }
+
+    CSYS_INLINE void System::RecordHit(const CommandKeyView &key)
+    {
+        // Set and get count for both the verb and the variable.
+        if (key.m_Verb == CommandVerb::SET || key.m_Verb == CommandVerb::GET)
+        {
+            m_CommandSuggestionTree.Hit(key.m_Verb == CommandVerb::SET ? s_Set : s_Get);
+            m_VariableSuggestionTree.Hit(key.m_Name);
+        } else
+            m_CommandSuggestionTree.Hit(key.m_Verb == CommandVerb::HELP ? s_Help : key.m_Name);
+    }
+
+    CSYS_INLINE void System::SeedHits(std::string_view line)
+    {
+        // Get name of command.
+        size_t index = 0;
+        auto range = String::NextPoi(line, index);
+        if (range.first > line.size())
+            return;
+        CommandKeyView key{CommandVerb::NONE, line.substr(range.first, range.second - range.first)};
+
+        // Verb followed by a name.
+        if (key.m_Name == s_Set || key.m_Name == s_Get || key.m_Name == s_Help)
+        {
+            CommandVerb verb = key.m_Name == s_Set ? CommandVerb::SET : key.m_Name == s_Get ? CommandVerb::GET : CommandVerb::HELP;
+            range = String::NextPoi(line, index);
+            if (range.first <= line.size())
+                key = CommandKeyView{verb, line.substr(range.first, range.second - range.first)};
+        }
+
+        RecordHit(key);
+    }
+
+    CSYS_INLINE void System::Execute(const CommandHandle &handle, const std::shared_ptr<CommandBase> &command,
+                                     const std::shared_ptr<VariableBase> &variable,
+                                     const std::shared_ptr<std::promise<Item>> &promise)
+    {
+        // Async command.
+        if (command && command->m_Async)
+        {
+            Submit(command, handle.m_Arguments, promise, handle.m_Line);
+            return;
+        }
+
+        // Execute command.
+        Item cmd_out(NONE);
+        if (handle.m_Verb == CommandVerb::SET)
+            cmd_out = variable->Run(*handle.m_Arguments);
+        else if (handle.m_Verb == CommandVerb::GET)
+            cmd_out = variable->Get(std::string_view(), m_ItemLog);
         else
+            cmd_out = command->Run(*handle.m_Arguments);
+
+        // Log output.
+        if (cmd_out.m_Type != NONE)
+            m_ItemLog.Items().emplace_back(cmd_out);
+
+        if (promise)
+            promise->set_value(std::move(cmd_out));
+    }
+
+    CSYS_INLINE void System::Submit(const std::shared_ptr<CommandBase> &command, std::shared_ptr<const ArgumentPack> arguments,
+                                    std::shared_ptr<std::promise<Item>> promise, std::string_view line)
+    {
+        // Default pool, one thread per core.
+        if (!m_ThreadPool)
+            m_ThreadPool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency());
+        if (!m_AsyncResults)
+            m_AsyncResults = std::make_shared<AsyncResults>();
+
+        // Task keeps command, arguments and output storage alive.
+        m_ThreadPool->Submit([command, arguments = std::move(arguments), promise = std::move(promise), results = m_AsyncResults,
+                              line = std::string(line)]()
         {
-            // Get the arguments.
-            String arguments = line.m_String.substr(range.second, line.m_String.size() - range.first);
+            // Exceptions go to the future, or are logged on poll when nobody waits on one.
+            auto fail = [&promise, &results, &line](const char *what)
+            {
+                if (promise)
+                {
+                    promise->set_exception(std::current_exception());
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(results->m_Mutex);
+                results->m_Items.push_back(Item(ERROR) << (line + ": " + what));
+            };
 
-            // Execute command.
-            auto cmd_out = (*command->second)(arguments);
+            Item cmd_out(NONE);
+            CSYS_TRY
+            {
+                cmd_out = command->Run(*arguments);
+            }
+            CSYS_CATCH(const std::exception &e)
+            {
+                fail(e.what());
+                return;
+            }
+            CSYS_CATCH_ALL
+            {
+                fail("unknown error");
+                return;
+            }
 
-            // Log output.
+            // Queue output for the owning thread, before the future becomes ready.
             if (cmd_out.m_Type != NONE)
-                m_ItemLog.Items().emplace_back(cmd_out);
-        }
+            {
+                std::lock_guard<std::mutex> lock(results->m_Mutex);
+                results->m_Items.push_back(cmd_out);
+            }
+
+            if (promise)
+                promise->set_value(std::move(cmd_out));
+        });
+    }
+
+    CSYS_INLINE void System::LogVariableError(const CommandKeyView &key, const Item &error)
+    {
+        Log(ERROR) << (key.m_Verb == CommandVerb::SET ? s_Set : s_Get) << ' ' << key.m_Name << ": " << error.m_Data;
     }
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_THREAD_POOL_H
+#define CSYS_THREAD_POOL_H
+#pragma once
+
+#include "csys/api.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Fixed set of worker threads running submitted tasks in submission order
+     */
+    class CSYS_API ThreadPool
+    {
+    public:
+
+        /*!
+         * \brief
+         *      Start worker threads
+         * \param threads
+         *      Number of worker threads (At least one is started)
+         */
+        explicit ThreadPool(size_t threads);
+
+        /*!
+         * \brief
+         *      Run every task still queued, then join worker threads
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /*!
+         * \brief
+         *      Queue a task to be ran by a worker thread
+         * \param task
+         *      Task to run
+         */
+        void Submit(std::function<void()> task);
+
+        /*!
+         * \return
+         *      Number of worker threads
+         */
+        [[nodiscard]] size_t Size() const;
+
+    protected:
+        void Work();                                    //!< Worker thread loop
+
+        std::vector<std::thread> m_Threads;             //!< Worker threads
+        std::deque<std::function<void()>> m_Tasks;      //!< Tasks waiting for a worker
+        std::mutex m_Mutex;                             //!< Guards m_Tasks and m_Stop
+        std::condition_variable m_Condition;            //!< Signals new tasks and shutdown
+        bool m_Stop = false;                            //!< Flag to determine if workers should exit once idle
+    };
+}
+
+#ifdef CSYS_HEADER_ONLY
+#include "csys/thread_pool.inl"
+#endif
+
+#endif //CSYS_THREAD_POOL_H
@@ -0,0 +1,78 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#ifndef CSYS_HEADER_ONLY
+
+#include "csys/thread_pool.h"
+
+#endif
+
+#include <utility>
+
+namespace csys
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Public methods /////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE ThreadPool::ThreadPool(size_t threads)
+    {
+        if (threads == 0) threads = 1;
+
+        m_Threads.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+            m_Threads.emplace_back([this]() { Work(); });
+    }
+
+    CSYS_INLINE ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Condition.notify_all();
+
+        for (auto &thread : m_Threads)
+            thread.join();
+    }
+
+    CSYS_INLINE void ThreadPool::Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.emplace_back(std::move(task));
+        }
+        m_Condition.notify_one();
+    }
+
+    CSYS_INLINE size_t ThreadPool::Size() const
+    {
+        return m_Threads.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Private methods ////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    CSYS_INLINE void ThreadPool::Work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+                // Only exit once every queued task ran.
+                if (m_Tasks.empty())
+                    return;
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
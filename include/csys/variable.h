@@ -0,0 +1,390 @@
+// Copyright (c) 2020-present, Roland Munguia & Tristan Florian Bouchard.
+// Distributed under the MIT License (http://opensource.org/licenses/MIT)
+
+#ifndef CSYS_VARIABLE_H
+#define CSYS_VARIABLE_H
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include "csys/arguments.h"
+#include "csys/command.h"
+#include "csys/exceptions.h"
+#include "csys/item.h"
+
+namespace csys
+{
+    /*!
+     * \brief
+     *      Non-templated class that allows for the storage of registered variables. A variable is set and read in
+     *      place, so it only needs a pointer to its storage and the type information to parse and log it
+     */
+    struct VariableBase
+    {
+        /*!
+         * \brief
+         *      Default virtual destructor
+         */
+        virtual ~VariableBase() = default;
+
+        /*!
+         * \brief
+         *      Parses the arguments and assigns the variable
+         * \param input
+         *      String of arguments to parse
+         * \return
+         *      Returns item error if the parsing in someway was messed up, and none if there was no issue
+         */
+        virtual Item Set(std::string_view input) = 0;
+
+        /*!
+         * \brief
+         *      Logs the value of the variable
+         * \param input
+         *      String of arguments, should be empty
+         * \param log
+         *      Log to write the value to
+         * \return
+         *      Returns item error if arguments were given, and none if there was no issue
+         */
+        virtual Item Get(std::string_view input, ItemLog &log) = 0;
+
+        /*!
+         * \brief
+         *      Parses the arguments of a set without assigning the variable
+         * \param input
+         *      String of arguments to parse
+         * \param[out] pack
+         *      Parsed arguments, only set if parsing succeeded
+         * \return
+         *      Returns item error if the parsing in someway was messed up, and none if there was no issue
+         */
+        virtual Item Compile(std::string_view input, std::unique_ptr<ArgumentPack> &pack) = 0;
+
+        /*!
+         * \brief
+         *      Assigns the variable with arguments previously parsed by Compile
+         * \param pack
+         *      Arguments returned by Compile on this same variable
+         * \return
+         *      Returns item none
+         */
+        virtual Item Run(const ArgumentPack &pack) = 0;
+
+        /*!
+         * \brief
+         *      Checks if an argument of a set is a boolean
+         * \param index
+         *      Position of the argument
+         * \return
+         *      Returns false if the argument isn't a boolean or a set takes fewer arguments
+         */
+        [[nodiscard]] virtual bool BoolArgument(size_t index) const = 0;
+
+        /*!
+         * \brief
+         *      Copies a variable (Storage is shared, not copied)
+         * \return
+         *      Pointer to newly copied variable
+         */
+        [[nodiscard]] virtual VariableBase *Clone() const = 0;
+    };
+
+    /*!
+     * \brief
+     *      Default variable setter, constructs the variable from the parsed arguments
+     * \tparam T
+     *      Type of the variable
+     * \tparam Types
+     *      Types the variable is constructed from
+     */
+    template<typename T, typename ...Types>
+    struct VariableConstructor
+    {
+        void operator()(T &var, Types... args) const
+        { var = T(std::move(args)...); }
+    };
+
+    /*!
+     * \brief
+     *      Registered variable of type T
+     * \tparam T
+     *      Type of the variable
+     * \tparam Setter
+     *      Callable of signature void(T&, Types...) ran on set
+     * \tparam Types
+     *      Types of the arguments a set takes
+     */
+    template<typename T, typename Setter, typename ...Types>
+    class CSYS_API Variable : public VariableBase
+    {
+    public:
+        /*!
+         * \brief
+         *      Constructor
+         * \param var
+         *      Variable storage, must outlive this object
+         * \param setter
+         *      Setter ran on set
+         */
+        Variable(T &var, Setter setter) : m_Var(&var), m_Setter(std::move(setter))
+        {}
+
+        /*!
+         * \brief
+         *      Parses the arguments and assigns the variable
+         * \param input
+         *      String of arguments to parse
+         * \return
+         *      Returns item error if the parsing in someway was messed up, and none if there was no issue
+         */
+        Item Set(std::string_view input) final
+        {
+            Values values;
+            if (auto error = Parse(input, values))
+                return Item(ERROR) << error.Message(input);
+
+            std::apply([this](auto &... value) { m_Setter(*m_Var, std::move(value)...); }, values);
+            return Item(NONE);
+        }
+
+        /*!
+         * \brief
+         *      Logs the value of the variable
+         * \param input
+         *      String of arguments, should be empty
+         * \param log
+         *      Log to write the value to
+         * \return
+         *      Returns item error if arguments were given, and none if there was no issue
+         */
+        Item Get(std::string_view input, ItemLog &log) final
+        {
+            size_t start = 0;
+            if (auto error = Arg<NULL_ARGUMENT>().TryParse(input, start))
+                return Item(ERROR) << error.Message(input);
+
+            log.log(LOG) << *m_Var << endl;
+            return Item(NONE);
+        }
+
+        /*!
+         * \brief
+         *      Parses the arguments of a set without assigning the variable
+         * \param input
+         *      String of arguments to parse
+         * \param[out] pack
+         *      Parsed arguments, only set if parsing succeeded
+         * \return
+         *      Returns item error if the parsing in someway was messed up, and none if there was no issue
+         */
+        Item Compile(std::string_view input, std::unique_ptr<ArgumentPack> &pack) final
+        {
+            Values values;
+            if (auto error = Parse(input, values))
+                return Item(ERROR) << error.Message(input);
+
+            pack = std::make_unique<Pack>(std::move(values));
+            return Item(NONE);
+        }
+
+        /*!
+         * \brief
+         *      Assigns the variable with arguments previously parsed by Compile
+         * \param pack
+         *      Arguments returned by Compile on this same variable
+         * \return
+         *      Returns item none
+         */
+        Item Run(const ArgumentPack &pack) final
+        {
+            std::apply([this](const auto &... values) { m_Setter(*m_Var, values...); }, static_cast<const Pack &>(pack).m_Values);
+            return Item(NONE);
+        }
+
+        /*!
+         * \brief
+         *      Checks if an argument of a set is a boolean
+         * \param index
+         *      Position of the argument
+         * \return
+         *      Returns false if the argument isn't a boolean or a set takes fewer arguments
+         */
+        [[nodiscard]] bool BoolArgument(size_t index) const final
+        {
+            size_t i = 0;
+            return ((i++ == index && std::is_same_v<typename Arg<Types>::ValueType, bool>) || ...);
+        }
+
+        /*!
+         * \brief
+         *      Copies a variable (Storage is shared, not copied)
+         * \return
+         *      Pointer to newly copied variable
+         */
+        [[nodiscard]] VariableBase *Clone() const final
+        {
+            return new Variable<T, Setter, Types...>(*this);
+        }
+
+    private:
+        using Values = std::tuple<typename Arg<Types>::ValueType...>;    //!< Parsed values of a set
+
+        /*!
+         * \brief
+         *      Parsed arguments of a set
+         */
+        struct Pack : ArgumentPack
+        {
+            explicit Pack(Values values) : m_Values(std::move(values))
+            {}
+
+            Values m_Values;    //!< Parsed values
+        };
+
+        /*!
+         * \brief
+         *      Parses the arguments of a set
+         * \param input
+         *      String of arguments to parse
+         * \param[out] values
+         *      Parsed values, partially set on failure
+         * \return
+         *      First parse error, empty if every argument was parsed
+         */
+        static ParseError Parse(std::string_view input, Values &values)
+        {
+            ArgumentTokens tokens(input);
+            ParseError error;
+
+            // Split once, then stop at the first argument that fails
+            std::apply([&](auto &... value)
+                       { (void) ((error = Arg<Types>::TryParseValue(input, tokens, value)) || ...); }, values);
+            if (error)
+                return error;
+            return Arg<NULL_ARGUMENT>().TryParse(input, tokens);
+        }
+
+        T *m_Var;            //!< Variable storage
+        Setter m_Setter;     //!< Setter ran on set
+    };
+
+    /*!
+     * \brief
+     *      Name of a registered variable
+     */
+    struct VariableKey
+    {
+        /*!
+         * \brief
+         *      Constructor
+         * \param name
+         *      Variable name
+         */
+        VariableKey(std::string name) : m_Name(std::move(name))
+        {}
+
+        /*!
+         * \brief
+         *      Key as a view
+         * \return
+         *      Name (The name searched for if this is a lookup key)
+         */
+        [[nodiscard]] std::string_view View() const
+        {
+            return m_Lookup ? m_LookupName : std::string_view(m_Name);
+        }
+
+        /*!
+         * \brief
+         *      Key as a view, so names can be read like the strings they are
+         */
+        operator std::string_view() const
+        {
+            return View();
+        }
+
+        std::string m_Name;    //!< Variable name
+
+    private:
+        friend class VariableMap;
+
+        /*!
+         * \brief
+         *      Key referring to a name instead of owning it, only used to search the map
+         * \param name
+         *      Name to search for
+         */
+        explicit VariableKey(std::string_view name) : m_Lookup(true), m_LookupName(name)
+        {}
+
+        bool m_Lookup = false;             //!< Flag to determine if this is a lookup key
+        std::string_view m_LookupName;     //!< Name searched for by a lookup key
+    };
+
+    /*!
+     * \brief
+     *      Hash of a VariableKey, from its name
+     */
+    struct VariableKeyHash
+    {
+        size_t operator()(const VariableKey &key) const
+        {
+            return std::hash<std::string_view>()(key.View());
+        }
+    };
+
+    /*!
+     * \brief
+     *      Equality of VariableKeys, compares their name
+     */
+    struct VariableKeyEqual
+    {
+        bool operator()(const VariableKey &lhs, const VariableKey &rhs) const
+        {
+            return lhs.View() == rhs.View();
+        }
+    };
+
+    /*!
+     * \brief
+     *      Registered variables container, hash map keyed by name that is searched without building a string
+     */
+    class VariableMap
+            : public std::unordered_map<VariableKey, std::shared_ptr<VariableBase>, VariableKeyHash, VariableKeyEqual>
+    {
+    public:
+        /*!
+         * \brief
+         *      Look up a variable without copying its name
+         * \param name
+         *      Variable name
+         * \return
+         *      Iterator to the variable, or end
+         */
+        iterator find(std::string_view name)
+        {
+            return unordered_map::find(VariableKey(name));
+        }
+
+        /*!
+         * \brief
+         *      Look up a variable without copying its name
+         * \param name
+         *      Variable name
+         * \return
+         *      Iterator to the variable, or end
+         */
+        const_iterator find(std::string_view name) const
+        {
+            return unordered_map::find(VariableKey(name));
+        }
+    };
+}
+
+#endif //CSYS_VARIABLE_H
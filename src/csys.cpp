@@ -7,6 +7,11 @@
 
 // We add .inl into .cpp to create a entry point to build everything from.
 #include "csys/autocomplete.inl"
+#include "csys/compact_autocomplete.inl"
+#include "csys/substring_index.inl"
+#include "csys/frozen_commands.inl"
+#include "csys/command_queue.inl"
+#include "csys/thread_pool.inl"
 #include "csys/system.inl"
 #include "csys/history.inl"
 #include "csys/item.inl"
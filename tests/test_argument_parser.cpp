@@ -0,0 +1,264 @@
+#include "doctest.h"
+#include "csys/arguments.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Parses a single argument of type T from the start of 'input'.
+template<typename T>
+static T Parse(std::string_view input)
+{
+    size_t start = 0;
+    return csys::Arg<T>::ParseValue(input, start);
+}
+
+// Checks that parsing a single argument of type T throws.
+template<typename T>
+static bool Throws(std::string_view input)
+{
+    try
+    {
+        Parse<T>(input);
+    }
+    catch (const csys::Exception &)
+    {
+        return true;
+    }
+    return false;
+}
+
+TEST_CASE ("Test csys argument parser")
+{
+    // Check numbers.
+    SUBCASE("Testing number arguments")
+    {
+        CHECK(Parse<int>("  42 ") == 42);
+        CHECK(Parse<int>("-7") == -7);
+        CHECK(Parse<int>("+7") == 7);
+        CHECK(Parse<unsigned short>("65535") == 65535);
+        CHECK(Parse<long long>("-9223372036854775808") == std::numeric_limits<long long>::min());
+        CHECK(Parse<float>("2.5") == 2.5f);
+        CHECK(Parse<double>("+1e3") == 1000.0);
+        CHECK(Parse<long double>("-0.5") == -0.5L);
+
+        CHECK(Throws<int>("abc"));
+        CHECK(Throws<int>("12abc"));
+        CHECK(Throws<int>("+-1"));
+        CHECK(Throws<short>("40000"));
+        CHECK(Throws<unsigned int>("-1"));
+        CHECK(Throws<float>("1e100"));
+        CHECK(Throws<int>("   "));
+    }
+
+    // Check booleans, chars and strings.
+    SUBCASE("Testing text arguments")
+    {
+        CHECK(Parse<bool>("TRUE") == true);
+        CHECK(Parse<bool>("False") == false);
+        CHECK(Throws<bool>("truth"));
+        CHECK(Throws<bool>("1"));
+
+        CHECK(Parse<char>("a") == 'a');
+        CHECK(Parse<char>("\\[") == '[');
+        CHECK(Throws<char>("ab"));
+        CHECK(Throws<char>("]"));
+
+        CHECK(Parse<csys::String>("word").m_String == "word");
+        CHECK(Parse<csys::String>("\"two words\"").m_String == "two words");
+        CHECK(Parse<csys::String>("\"a\"\"b\"").m_String == "ab");
+        CHECK(Parse<csys::String>("\"a\\\" b\"").m_String == "a\" b");
+        CHECK(Throws<csys::String>("\"open"));
+    }
+
+    // Check vectors.
+    SUBCASE("Testing vector arguments")
+    {
+        CHECK(Parse<std::vector<int>>("[1 2 3]") == std::vector<int>({1, 2, 3}));
+        CHECK(Parse<std::vector<int>>("[ ]").empty());
+        CHECK(Parse<std::vector<std::vector<int>>>("[[1 2] [] [3]]") == std::vector<std::vector<int>>({{1, 2}, {}, {3}}));
+        CHECK(Throws<std::vector<int>>("1 2"));
+        CHECK(Throws<std::vector<int>>("[1 2"));
+        CHECK(Throws<std::vector<int>>("["));
+
+        // Parsing stops after the closing ].
+        std::string_view input = "[1 2] 3";
+        size_t start = 0;
+        CHECK(csys::Arg<std::vector<int>>::ParseValue(input, start).size() == 2);
+        CHECK(csys::Arg<int>::ParseValue(input, start) == 3);
+    }
+
+    // Check errors are reported without throwing.
+    SUBCASE("Testing parse error codes")
+    {
+        std::string_view input = "1 [2 x] 3";
+        size_t start = 0;
+        int value = 0;
+        CHECK(!csys::Arg<int>::TryParseValue(input, start, value));
+        CHECK(value == 1);
+
+        std::vector<int> vector;
+        auto error = csys::Arg<std::vector<int>>::TryParseValue(input, start, vector);
+        CHECK(error.m_Code == csys::ParseErrorCode::INVALID_NUMBER);
+        CHECK(input.substr(error.m_First, error.m_Last - error.m_First) == "x");
+        CHECK(error.Message(input) == "Missing or invalid signed int argument: 'x'");
+
+        start = 0;
+        CHECK(csys::Arg<csys::NULL_ARGUMENT>().TryParse(input, start).m_Code == csys::ParseErrorCode::TOO_MANY_ARGUMENTS);
+        start = input.size();
+        CHECK(csys::Arg<int>::TryParseValue(input, start, value).m_Code == csys::ParseErrorCode::NOT_ENOUGH_ARGUMENTS);
+    }
+
+    // Check command lines are split into whole arguments.
+    SUBCASE("Testing command line tokens")
+    {
+        auto Split = [](std::string_view input)
+        {
+            std::vector<std::string_view> tokens;
+            csys::ArgumentTokens split(input);
+            std::pair<size_t, size_t> token;
+            while (split.Next(token))
+                tokens.push_back(input.substr(token.first, token.second - token.first));
+            return tokens;
+        };
+
+        CHECK(Split("  ").empty());
+        CHECK(Split(" a  bc ") == std::vector<std::string_view>({"a", "bc"}));
+        CHECK(Split("\"x y\" \"a\"\"b\" \"\\\" z\" w") == std::vector<std::string_view>({"\"x y\"", "\"a\"\"b\"", "\"\\\" z\"", "w"}));
+        CHECK(Split("[[1 2] [3]] [\\] 4] 5") == std::vector<std::string_view>({"[[1 2] [3]]", "[\\] 4]", "5"}));
+        CHECK(Split("[1 \"open") == std::vector<std::string_view>({"[1 \"open"}));
+
+        // More arguments than fit in a batch.
+        std::string input;
+        for (int i = 0; i < 70; ++i)
+            input += std::to_string(i) + " ";
+        auto tokens = Split(input);
+        REQUIRE(tokens.size() == 70);
+        CHECK(tokens[31] == "31");
+        CHECK(tokens[32] == "32");
+        CHECK(tokens[69] == "69");
+
+        csys::ArgumentTokens split(input);
+        std::vector<int> values(70);
+        for (int &value : values)
+            CHECK(!csys::Arg<int>::TryParseValue(input, split, value));
+        CHECK(values[64] == 64);
+        CHECK(csys::Arg<int>::TryParseValue(input, split, values[0]).m_Code == csys::ParseErrorCode::NOT_ENOUGH_ARGUMENTS);
+    }
+
+    // Check input is never modified, so it can be parsed again.
+    SUBCASE("Testing input is left untouched")
+    {
+        const std::string input = "TRUE [4 5] \"x y\"";
+        for (int i = 0; i < 2; ++i)
+        {
+            size_t start = 0;
+            CHECK(csys::Arg<bool>::ParseValue(input, start));
+            CHECK(csys::Arg<std::vector<int>>::ParseValue(input, start) == std::vector<int>({4, 5}));
+            CHECK(csys::Arg<csys::String>::ParseValue(input, start).m_String == "x y");
+        }
+        CHECK(input == "TRUE [4 5] \"x y\"");
+    }
+}
+
+// Best time of a few runs of parsing 'input' as a single argument of type T, in seconds.
+template<typename T>
+static double ParseTime(const std::string &input)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < 5; ++i)
+    {
+        T value{};
+        size_t start = 0;
+        auto before = std::chrono::steady_clock::now();
+        (void) csys::Arg<T>::TryParseValue(input, start, value);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count());
+    }
+    return best;
+}
+
+TEST_CASE ("Test csys argument parser worst case")
+{
+    // Check random lines made of reserved chars never break the parsers.
+    SUBCASE("Testing random input")
+    {
+        const char alphabet[] = {'\\', '"', '[', ']', ' ', 'a', '1', '-'};
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<size_t> length(0, 24), pick(0, sizeof(alphabet) - 1);
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            std::string input(length(rng), ' ');
+            for (char &c : input)
+                c = alphabet[pick(rng)];
+
+            // Tokens are in order and hold no whitespace at their ends.
+            csys::ArgumentTokens tokens(input);
+            std::pair<size_t, size_t> token;
+            size_t last = 0;
+            while (tokens.Next(token))
+            {
+                REQUIRE(token.first >= last);
+                REQUIRE(token.first < token.second);
+                REQUIRE(token.second <= input.size());
+                REQUIRE(!csys::Scan::IsSpace(input[token.first]));
+                last = token.second;
+            }
+
+            // Errors stay within the input, and parsed strings read the same once escaped and quoted again.
+            auto Check = [&input](auto value)
+            {
+                size_t start = 0;
+                auto error = csys::Arg<decltype(value)>::TryParseValue(input, start, value);
+                CHECK(error.m_First <= error.m_Last);
+                CHECK(error.m_Last <= input.size());
+                CHECK(start <= input.size());
+                (void) error.Message(input);
+                return !error;
+            };
+            Check(int());
+            Check(char());
+            Check(std::vector<csys::String>());
+            Check(std::vector<std::vector<int>>());
+
+            csys::String value;
+            size_t start = 0;
+            if (!csys::Arg<csys::String>::TryParseValue(input, start, value))
+            {
+                std::string quoted = "\"";
+                for (char c : value.m_String)
+                    quoted += csys::Reserved::IsReservedChar(c) ? std::string("\\") + c : std::string(1, c);
+                quoted += "\"";
+                CHECK(Parse<csys::String>(quoted).m_String == value.m_String);
+            }
+        }
+    }
+
+    // Check parse time grows linearly with the length of escape heavy input.
+    SUBCASE("Testing parse time is linear")
+    {
+        auto Repeat = [](const std::string &open, const std::string &part, const std::string &close, size_t count)
+        {
+            std::string input = open;
+            for (size_t i = 0; i < count; ++i)
+                input += part;
+            return input + close;
+        };
+
+        // A quadratic parser takes 256 times longer on 16 times more input.
+        const size_t small = 1 << 12, large = small * 16;
+        auto Linear = [&](auto parse, const std::string &open, const std::string &part, const std::string &close)
+        {
+            double ratio = parse(Repeat(open, part, close, large)) / std::max(parse(Repeat(open, part, close, small)), 1e-7);
+            CHECK(ratio < 64);
+        };
+
+        Linear(ParseTime<csys::String>, "\"", "\\\"", "\"");
+        Linear(ParseTime<csys::String>, "\"", "\\\\", "");
+        Linear(ParseTime<std::vector<char>>, "[", "\\] ", "]");
+        Linear(ParseTime<std::vector<csys::String>>, "[", "\"\\\\\\]\" ", "]");
+        Linear(ParseTime<std::vector<std::vector<int>>>, "", "[", "");
+    }
+}
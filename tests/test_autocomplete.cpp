@@ -3,6 +3,7 @@
 #include "csys/autocomplete.h"
 #include <algorithm>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define SEARCH_CHECK(word){\
@@ -41,6 +42,14 @@
         CHECK_MESSAGE(check_2, std::string("Partial completion did not match expected output -> ") + partial + " != " + partial_ac);\
     }
 
+// Exposes the node pool to check which copies still share it.
+struct NodeProbe : csys::AutoComplete
+{
+    using csys::AutoComplete::AutoComplete;
+    explicit NodeProbe(const csys::AutoComplete &tree) : csys::AutoComplete(tree) {}
+    const void *Nodes() const { return m_Nodes.data(); }
+};
+
 TEST_CASE ("Autocomplete")
 {
     csys::AutoComplete tree({"roland", "munguia", "12345", "michael", "rino", "muchos"});
@@ -107,6 +116,174 @@ TEST_CASE ("Autocomplete")
         SUGGESTION_PARTIAL_CHECK(tree2, "r", "rol", "rolipoli", "rolling");
     }
 
+    // Bounded visitor and count.
+    SUBCASE("Visiting top suggestions")
+    {
+        std::vector<std::string> visited;
+        auto visit = [&visited](std::string_view word) { visited.emplace_back(word); };
+        CHECK(tree2.Suggestions("r", 2, visit) == 2);
+        CHECK(visited == std::vector<std::string>({"roland", "rolipoli"}));
+        CHECK(tree2.SuggestionCount("r") == 3);
+
+        visited.clear();
+        CHECK(tree2.Suggestions("m", 10, visit) == 3);
+        CHECK(visited == std::vector<std::string>({"michael", "muchos", "munguia"}));
+        CHECK(tree2.SuggestionCount("mu") == 2);
+
+        CHECK(tree2.Suggestions("", 100, [](std::string_view) {}) == tree2.Count());
+        CHECK(tree2.SuggestionCount("") == tree2.Count());
+        CHECK(tree2.Suggestions("x", 10, visit) == 0);
+        CHECK(tree2.Suggestions("r", 0, visit) == 0);
+        CHECK(tree2.SuggestionCount("roland") == 0);
+    }
+
+    // Typo tolerant search.
+    SUBCASE("Fuzzy suggestions")
+    {
+        std::vector<std::string> results;
+        tree2.FuzzySuggestions("rolnad", 2, 5, results);
+        CHECK(results == std::vector<std::string>({"roland"}));
+
+        results.clear();
+        tree2.FuzzySuggestions("muchas", 1, 5, results);
+        CHECK(results == std::vector<std::string>({"muchos"}));
+
+        // Closest first, then shortest.
+        results.clear();
+        tree2.FuzzySuggestions("rolin", 3, 5, results);
+        CHECK(results == std::vector<std::string>({"roland", "rolling"}));
+
+        results.clear();
+        tree2.FuzzySuggestions("rolin", 3, 1, results);
+        CHECK(results.size() == 1);
+
+        results.clear();
+        tree2.FuzzySuggestions("zzzz", 2, 5, results);
+        CHECK(results.empty());
+    }
+
+    // Most used first.
+    SUBCASE("Ranked suggestions")
+    {
+        std::vector<std::string> results;
+        CHECK(!tree2.HitsEnabled());
+        tree2.RankedSuggestions("r", 2, results);
+        CHECK(results == std::vector<std::string>({"roland", "rolipoli"}));
+
+        CHECK(tree2.Hit("rolling", 3));
+        CHECK(tree2.Hit("rolipoli"));
+        CHECK(tree2.Hit("munguia", 2));
+        CHECK(!tree2.Hit("rol"));
+        CHECK(!tree2.Hit("missing"));
+        CHECK(tree2.HitsEnabled());
+        CHECK(tree2.Hits("rolling") == 3);
+        CHECK(tree2.Hits("roland") == 0);
+
+        results.clear();
+        tree2.RankedSuggestions("r", 10, results);
+        CHECK(results == std::vector<std::string>({"rolling", "rolipoli", "roland"}));
+
+        results.clear();
+        tree2.RankedSuggestions("", 3, results);
+        CHECK(results == std::vector<std::string>({"rolling", "munguia", "rolipoli"}));
+
+        // Ties are alphabetical.
+        results.clear();
+        tree2.RankedSuggestions("m", 10, results);
+        CHECK(results == std::vector<std::string>({"munguia", "michael", "muchos"}));
+
+        // Removed words lose their counter.
+        tree2.Remove("rolling");
+        tree2.Insert("rolling");
+        CHECK(tree2.Hits("rolling") == 0);
+        results.clear();
+        tree2.RankedSuggestions("r", 1, results);
+        CHECK(results == std::vector<std::string>({"rolipoli"}));
+
+        tree2.ClearHits();
+        CHECK(tree2.Hits("munguia") == 0);
+    }
+
+    // Prefix typed a character at a time.
+    SUBCASE("Cursor")
+    {
+        csys::AutoComplete::Cursor cursor(tree2);
+        std::vector<std::string> results;
+        CHECK(cursor.Matches());
+        CHECK(cursor.SuggestionCount() == tree2.Count());
+
+        CHECK(cursor.Push('r'));
+        cursor.Suggestions(results);
+        CHECK(results == std::vector<std::string>({"roland", "rolipoli", "rolling"}));
+
+        // Shared characters.
+        CHECK(cursor.Complete() == 2);
+        CHECK(cursor.Prefix() == "rol");
+        CHECK(cursor.Push('l'));
+        CHECK(cursor.Complete() == 2);
+        CHECK(cursor.Prefix() == "rollin");
+        CHECK(!cursor.IsWord());
+        CHECK(cursor.Push('g'));
+        CHECK(cursor.IsWord());
+        CHECK(cursor.SuggestionCount() == 0);
+
+        // Backspace.
+        for (int i = 0; i < 4; ++i)
+            CHECK(cursor.Pop());
+        CHECK(cursor.Prefix() == "rol");
+        CHECK(!cursor.Push('x'));
+        CHECK(!cursor.Push('y'));
+        CHECK(!cursor.Matches());
+        CHECK(cursor.Suggestions(10, [](std::string_view) {}) == 0);
+        CHECK(cursor.Pop());
+        CHECK(cursor.Pop());
+
+        // Modified tree is noticed.
+        CHECK(cursor.Valid());
+        tree2.Insert("rolex");
+        CHECK(!cursor.Valid());
+        results.clear();
+        CHECK(cursor.Suggestions(2, [&results](std::string_view word) { results.emplace_back(word); }) == 2);
+        CHECK(results == std::vector<std::string>({"roland", "rolex"}));
+        CHECK(cursor.Valid());
+
+        tree2.Remove("rolex");
+        CHECK(!cursor.Push('e'));
+        CHECK(!cursor.Matches());
+
+        cursor.Clear();
+        CHECK(cursor.Prefix().empty());
+        CHECK(!cursor.Pop());
+    }
+
+    // Removed nodes are reused.
+    SUBCASE("Reusing removed nodes")
+    {
+        size_t size = tree2.Size();
+        tree2.Insert("rolex");
+        CHECK(tree2.Size() == size + 2);
+        CHECK(tree2.Count() == 8);
+        tree2.Remove("rolex");
+        CHECK(tree2.Size() == size);
+        CHECK(tree2.Count() == 7);
+        tree2.Insert("rolux");
+        CHECK(tree2.Size() == size + 2);
+        CHECK(tree2.Search("rolux"));
+        CHECK(!tree2.Search("rolex"));
+    }
+
+    // Moving tree.
+    SUBCASE("Moving trees")
+    {
+        csys::AutoComplete mTree(std::move(tree));
+        CHECK(mTree.Search("roland"));
+        CHECK(tree.Size() == 0);
+        CHECK(!tree.Search("roland"));
+        tree.Insert("moved");
+        CHECK(tree.Search("moved"));
+        CHECK(!mTree.Search("moved"));
+    }
+
     // Copying tree.
     SUBCASE("Copying trees")
     {
@@ -130,5 +307,141 @@ TEST_CASE ("Autocomplete")
         CHECK(aTree.Search("rino"));
         CHECK(aTree.Search("muchos"));
     }
+
+    // Copies share nodes until modified.
+    SUBCASE("Sharing copied trees")
+    {
+        tree.Hit("rino", 2);
+        csys::AutoComplete copy(tree);
+        csys::AutoComplete::Cursor cursor(tree);
+        cursor.Push('m');
+        cursor.Push('u');
+
+        // Either side writes to its own nodes.
+        copy.Insert("mute");
+        copy.Hit("rino");
+        tree.Remove("muchos");
+        CHECK(copy.Search("mute"));
+        CHECK(copy.Search("muchos"));
+        CHECK(copy.Hits("rino") == 3);
+        CHECK(!tree.Search("mute"));
+        CHECK(!tree.Search("muchos"));
+        CHECK(tree.Hits("rino") == 2);
+        CHECK(copy.Count() == tree.Count() + 2);
+
+        // Copy changes don't touch cursors of the original.
+        CHECK(cursor.Complete() == 4);
+        copy.Remove("munguia");
+        CHECK(cursor.Valid());
+        CHECK(cursor.Prefix() == "mungui");
+        CHECK(tree.Search("munguia"));
+
+        // Missing words leave the copy as is.
+        csys::AutoComplete other(tree);
+        other.Remove("missing");
+        CHECK(other.Count() == tree.Count());
+        tree.ClearHits();
+        CHECK(other.Hits("rino") == 2);
+    }
+
+    // Counters and no-op changes don't copy shared nodes.
+    SUBCASE("Keeping copied nodes shared")
+    {
+        tree.EnableHits();
+        NodeProbe original(tree);
+        NodeProbe copy(original);
+        copy.Hit("rino", 3);
+        copy.Insert("rino");
+        copy.Remove("missing");
+        CHECK(copy.Nodes() == original.Nodes());
+        CHECK(copy.Hits("rino") == 3);
+        CHECK(original.Hits("rino") == 0);
+
+        // Real changes still copy them.
+        copy.Remove("rino");
+        CHECK(copy.Nodes() != original.Nodes());
+        CHECK(copy.Hits("rino") == 0);
+        CHECK(original.Search("rino"));
+
+        // Copies of one tree on several threads only write their own nodes and counters.
+        original.Hit("roland", 2);
+        std::vector<std::thread> threads;
+        std::vector<int> valid(4, 0);
+        for (size_t t = 0; t < valid.size(); ++t)
+        {
+            threads.emplace_back([&original, &valid, t]()
+            {
+                std::string word = "thread_" + std::to_string(t);
+                for (int i = 0; i < 100; ++i)
+                {
+                    csys::AutoComplete session(static_cast<const csys::AutoComplete &>(original));
+                    session.Hit("roland");
+                    session.Insert(word.c_str());
+                    valid[t] += session.Search(word.c_str()) && session.Hits("roland") == 3 && session.Count() == original.Count() + 1;
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        CHECK(valid == std::vector<int>(4, 100));
+        CHECK(original.Hits("roland") == 2);
+        CHECK(!original.Search("thread_0"));
+    }
+
+    // Balanced building.
+    SUBCASE("Balancing")
+    {
+        // Sorted insertion chains siblings.
+        std::vector<std::string> words;
+        for (char first = 'a'; first <= 'z'; ++first)
+            for (char second = 'a'; second <= 'z'; ++second)
+                words.push_back(std::string{first, second, 'x'});
+        csys::AutoComplete chained;
+        for (const auto &word : words)
+            chained.Insert(word);
+        auto chained_stats = chained.Statistics();
+        CHECK(chained_stats.m_Words == words.size());
+        CHECK(chained_stats.m_Nodes == chained.Size());
+        CHECK(chained_stats.m_AverageLength == 3);
+        CHECK(chained_stats.m_MaxDepth == 26 + 26 + 1);
+
+        // Built at once, from any order.
+        std::reverse(words.begin(), words.end());
+        words.push_back("mmx");
+        words.push_back("");
+        csys::AutoComplete built(words);
+        auto built_stats = built.Statistics();
+        CHECK(built.Count() == 26 * 26);
+        CHECK(built.Size() == chained.Size());
+        CHECK(built_stats.m_MaxDepth <= 5 + 5 + 1);
+        CHECK(built_stats.m_AverageDepth < chained_stats.m_AverageDepth / 2);
+        for (const auto &word : words)
+            CHECK(built.Search(word.c_str()) == !word.empty());
+
+        // Rebalanced in place, keeping counters.
+        chained.Hit("abx", 5);
+        chained.Hit("zzx", 2);
+        chained.Rebalance();
+        CHECK(chained.Statistics().m_MaxDepth == built_stats.m_MaxDepth);
+        CHECK(chained.Size() == built.Size());
+        CHECK(chained.Count() == built.Count());
+        CHECK(chained.Hits("abx") == 5);
+        std::vector<std::string> ranked;
+        chained.RankedSuggestions("", 3, ranked);
+        CHECK(ranked == std::vector<std::string>({"abx", "zzx", "aax"}));
+        std::vector<std::string> all;
+        chained.Suggestions("", SIZE_MAX, [&all](std::string_view word) { all.emplace_back(word); });
+        std::sort(words.begin(), words.end());
+        words.erase(words.begin());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        CHECK(all == words);
+
+        // Still editable.
+        chained.Insert("abz");
+        chained.Remove("abx");
+        CHECK(chained.Search("abz"));
+        CHECK(!chained.Search("abx"));
+        CHECK(chained.Search("aby") == false);
+    }
 }
 
@@ -0,0 +1,127 @@
+#include "doctest.h"
+#include "csys/system.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE ("Test csys command queue")
+{
+    // Check ordering and bounds.
+    SUBCASE("Testing queue push and pop")
+    {
+        csys::CommandQueue queue(3, 8);
+        CHECK(queue.Capacity() == 4);
+
+        CHECK(queue.Push("a"));
+        CHECK(queue.Push(""));
+        CHECK(!queue.Push("too long line"));
+        CHECK(queue.Push("b"));
+        CHECK(queue.Push("c"));
+        CHECK(!queue.Push("d"));
+
+        std::vector<std::string> lines;
+        while (queue.Pop([&lines](std::string_view line) { lines.emplace_back(line); }));
+        CHECK(lines == std::vector<std::string>({"a", "", "b", "c"}));
+
+        // Slots are reused after wrapping.
+        CHECK(queue.Push("e"));
+        CHECK(queue.Pop([](std::string_view line) { CHECK(line == "e"); }));
+        CHECK(!queue.Pop([](std::string_view) {}));
+    }
+
+    // Check system drains lines like RunCommand.
+    SUBCASE("Testing system enqueue")
+    {
+        csys::System temp;
+        int sum = 0;
+        temp.RegisterCommand("add", "", [&sum](int a) { sum += a; }, csys::Arg<int>("a"));
+
+        CHECK(!temp.Enqueue("add 1"));
+        temp.CreateQueue(16);
+        CHECK(temp.Enqueue("add 1"));
+        CHECK(temp.Enqueue("add 2"));
+        CHECK(temp.Enqueue("add 3"));
+
+        size_t items = temp.Items().size();
+        CHECK(temp.DrainQueue(2) == 2);
+        CHECK(sum == 3);
+        CHECK(temp.DrainQueue() == 1);
+        CHECK(sum == 6);
+        CHECK(temp.DrainQueue() == 0);
+        CHECK(temp.Items().size() == items + 3);
+        CHECK(temp.History().GetNew() == "add 3");
+    }
+
+    // Check queued commands that drain, refill or recreate the queue.
+    SUBCASE("Testing reentrant drains")
+    {
+        csys::System temp;
+        temp.CreateQueue(2, 16);
+        size_t nested = SIZE_MAX;
+        std::vector<std::string> lines;
+        temp.RegisterCommand("drain", "", [&]() { nested = temp.DrainQueue(); });
+        temp.RegisterCommand("requeue", "", [&]() { CHECK(temp.Enqueue("echo again")); });
+        temp.RegisterCommand("recreate", "", [&]() { temp.CreateQueue(64, 64); });
+        temp.RegisterCommand("echo", "", [&](csys::String line) { lines.emplace_back(line.m_String); },
+                             csys::Arg<csys::String>("line"));
+
+        CHECK(temp.Enqueue("drain"));
+        CHECK(temp.Enqueue("echo first"));
+        CHECK(temp.DrainQueue() == 2);
+        CHECK(nested == 0);
+        CHECK(lines == std::vector<std::string>({"first"}));
+
+        // Slots are free while the command runs, lines queued by it run in the same drain.
+        CHECK(temp.Enqueue("requeue"));
+        CHECK(temp.Enqueue("recreate"));
+        CHECK(temp.DrainQueue() == 3);
+        CHECK(lines == std::vector<std::string>({"first", "again"}));
+        CHECK(temp.DrainQueue() == 0);
+    }
+
+    // Check concurrent producers.
+    SUBCASE("Testing queue with 8 producers")
+    {
+        constexpr int producers = 8;
+        constexpr int per_producer = 10000;
+
+        csys::System temp;
+        std::vector<long long> sums(producers, 0);
+        temp.RegisterCommand("add", "", [&sums](int producer, int value) { sums[size_t(producer)] += value; },
+                             csys::Arg<int>("producer"), csys::Arg<int>("value"));
+        temp.CreateQueue(256);
+
+        std::atomic<int> done(0);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&temp, &done, p]()
+            {
+                for (int i = 1; i <= per_producer; ++i)
+                {
+                    std::string line = "add " + std::to_string(p) + " " + std::to_string(i);
+                    while (!temp.Enqueue(line))
+                        std::this_thread::yield();
+                }
+                ++done;
+            });
+        }
+
+        // Owning thread drains while producers run.
+        size_t drained = 0;
+        while (done.load() < producers)
+        {
+            drained += temp.DrainQueue(64);
+            temp.Items().clear();
+        }
+        for (auto &thread : threads)
+            thread.join();
+        drained += temp.DrainQueue();
+
+        CHECK(drained == size_t(producers * per_producer));
+        for (int p = 0; p < producers; ++p)
+            CHECK(sums[size_t(p)] == (long long)per_producer * (per_producer + 1) / 2);
+    }
+}
@@ -0,0 +1,106 @@
+#include "doctest.h"
+#include "csys/compact_autocomplete.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Sorted suggestions of a tree or index.
+template<typename Tree>
+static std::vector<std::string> Sorted(Tree &tree, const char *prefix)
+{
+    auto results = *tree.Suggestions(prefix);
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+TEST_CASE ("Compact autocomplete")
+{
+    std::vector<std::string> words({"roland", "munguia", "12345", "michael", "rino", "muchos", "rolling", "rolipoli",
+                                    "testing", "resting", "nesting"});
+    csys::AutoComplete tree(words);
+    csys::CompactAutoComplete compact(tree);
+
+    // Same answers as the source tree.
+    SUBCASE("Matching the source tree")
+    {
+        CHECK(compact.Count() == tree.Count());
+        for (const auto &word : words)
+            CHECK(compact.Search(word.c_str()));
+        CHECK(!compact.Search("rol"));
+        CHECK(!compact.Search("rolandx"));
+
+        for (const char *prefix : {"r", "ro", "m", "mu", "1", "x", "t"})
+            CHECK(Sorted(compact, prefix) == Sorted(tree, prefix));
+
+        for (const char *prefix : {"", "r", "m", "x"})
+            CHECK(compact.SuggestionCount(prefix) == tree.SuggestionCount(prefix));
+        std::string first;
+        CHECK(compact.Suggestions("mu", 1, [&first](std::string_view word) { first = word; }) == 1);
+        CHECK(first == "muchos");
+
+        std::vector<std::string> tree_results, compact_results;
+        CHECK(compact.Suggestions(std::string("r"), compact_results) == tree.Suggestions(std::string("r"), tree_results));
+    }
+
+    // Shared suffixes are stored once.
+    SUBCASE("Minimizing")
+    {
+        CHECK(compact.Size() < tree.Size());
+        csys::AutoComplete suffixes({"testing", "resting", "nesting"});
+        CHECK(csys::CompactAutoComplete(suffixes).Size() == 9);
+    }
+
+    // Saved and mapped back.
+    SUBCASE("Saving and mapping")
+    {
+        const char *path = "temp_compact_autocomplete.bin";
+        CHECK(compact.Save(path));
+
+        csys::CompactAutoComplete mapped;
+        CHECK(mapped.Map(path));
+        CHECK(mapped.Size() == compact.Size());
+        CHECK(mapped.Count() == compact.Count());
+        for (const auto &word : words)
+            CHECK(mapped.Search(word.c_str()));
+        CHECK(Sorted(mapped, "mu") == Sorted(tree, "mu"));
+
+        // Moving keeps the mapping.
+        csys::CompactAutoComplete moved(std::move(mapped));
+        CHECK(moved.Search("roland"));
+        CHECK(!mapped.Search("roland"));
+
+        CHECK(!mapped.Map("missing_compact_autocomplete.bin"));
+        std::remove(path);
+    }
+
+    // Corrupted links are rejected.
+    SUBCASE("Mapping bad links")
+    {
+        const char *path = "temp_compact_autocomplete_links.bin";
+        CHECK(compact.Save(path));
+
+        // Root is the last node, point its left child at itself then past the end.
+        std::string bytes;
+        {
+            std::ifstream file(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        size_t offset = bytes.size() - sizeof(csys::AutoComplete::ACNode) + offsetof(csys::AutoComplete::ACNode, m_Less);
+        for (auto link : {csys::AutoComplete::NodeIndex(compact.Size()), csys::AutoComplete::NodeIndex(0x7FFFFFFF)})
+        {
+            std::memcpy(&bytes[offset], &link, sizeof(link));
+            std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), std::streamsize(bytes.size()));
+
+            csys::CompactAutoComplete mapped;
+            CHECK(!mapped.Map(path));
+            CHECK(mapped.Count() == 0);
+            CHECK(!mapped.Search("roland"));
+        }
+        std::remove(path);
+    }
+}
@@ -0,0 +1,52 @@
+#include "doctest.h"
+#include "csys/scan.h"
+#include <random>
+#include <string>
+
+// First position at or after 'pos' accepted by 'match', one char at a time.
+template<typename Match>
+static size_t Reference(const std::string &str, size_t pos, Match match)
+{
+    for (; pos < str.size(); ++pos)
+        if (match(str[pos]))
+            return pos;
+    return str.size();
+}
+
+TEST_CASE ("Scanning whitespace")
+{
+    // Fixed set, whatever the locale.
+    SUBCASE("Whitespace chars")
+    {
+        for (char c : std::string(" \t\n\v\f\r", 6))
+            CHECK(csys::Scan::IsSpace(c));
+        CHECK(csys::Scan::IsSpace('\0'));
+        for (char c : {'a', '\b', '\x0E', '\x1F', '!', '\x85', '\xA0'})
+            CHECK(!csys::Scan::IsSpace(c));
+    }
+
+    // Blocks must give the same answers as a char at a time, at every offset and across block ends.
+    SUBCASE("Matches scalar scan")
+    {
+        const std::string alphabet(" \t\n\v\f\r\0a]\\\"[\x80\xFF\x08\x0E", 16);
+        std::mt19937 rng(99);
+        std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1), run(0, 80);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            // Long runs of one class so blocks are skipped whole.
+            std::string str;
+            while (str.size() < 150)
+                str.append(run(rng), alphabet[pick(rng)]);
+
+            for (size_t pos = 0; pos <= str.size() + 1; ++pos)
+            {
+                CHECK(csys::Scan::SkipSpace(str, pos) == Reference(str, pos, [](char c) { return !csys::Scan::IsSpace(c); }));
+                CHECK(csys::Scan::FindSpace(str, pos) == Reference(str, pos, csys::Scan::IsSpace));
+                CHECK(csys::Scan::FindSpaceOr<']', '\\'>(str, pos) ==
+                      Reference(str, pos, [](char c) { return csys::Scan::IsSpace(c) || c == ']' || c == '\\'; }));
+                CHECK(csys::Scan::FindAny<'"', '\n'>(str, pos) == Reference(str, pos, [](char c) { return c == '"' || c == '\n'; }));
+            }
+        }
+    }
+}
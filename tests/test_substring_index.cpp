@@ -0,0 +1,62 @@
+#include "doctest.h"
+#include "csys/substring_index.h"
+#include <string>
+#include <vector>
+
+// Search results of an index.
+static std::vector<std::string> Found(const csys::SubstringIndex &index, std::string_view query, size_t max_results = 10)
+{
+    std::vector<std::string> results;
+    index.Search(query, max_results, results);
+    return results;
+}
+
+TEST_CASE ("Substring index")
+{
+    csys::SubstringIndex index;
+    for (const char *name : {"r_shadow_quality", "r_shadow_bias", "shadow_enable", "r_noshadows", "cl_fov", "Shadowmap_size"})
+        index.Insert(name);
+    index.Insert("cl_fov");
+    CHECK(index.Count() == 6);
+
+    // Name start, then token start, then anywhere.
+    SUBCASE("Ranking matches")
+    {
+        CHECK(Found(index, "shadow") == std::vector<std::string>({"shadow_enable", "Shadowmap_size", "r_shadow_bias",
+                                                                 "r_shadow_quality", "r_noshadows"}));
+        CHECK(Found(index, "shadow", 2) == std::vector<std::string>({"shadow_enable", "Shadowmap_size"}));
+        CHECK(Found(index, "SHADOW_B") == std::vector<std::string>({"r_shadow_bias"}));
+        CHECK(Found(index, "ow_").size() == 3);
+        CHECK(Found(index, "shadow", 0).empty());
+    }
+
+    // Shorter than a trigram.
+    SUBCASE("Short queries")
+    {
+        CHECK(Found(index, "fo") == std::vector<std::string>({"cl_fov"}));
+        CHECK(Found(index, "").size() == 6);
+        CHECK(Found(index, "k").empty());
+    }
+
+    // Holding every trigram is not enough.
+    SUBCASE("Verifying candidates")
+    {
+        index.Insert("abcxbcd");
+        CHECK(Found(index, "abcd").empty());
+        CHECK(Found(index, "bcd") == std::vector<std::string>({"abcxbcd"}));
+        CHECK(Found(index, "missing").empty());
+    }
+
+    SUBCASE("Removing names")
+    {
+        index.Remove("r_shadow_bias");
+        index.Remove("not_there");
+        CHECK(index.Count() == 5);
+        CHECK(Found(index, "bias").empty());
+
+        // Freed id is reused.
+        index.Insert("r_shadow_softness");
+        CHECK(Found(index, "shadow_s") == std::vector<std::string>({"r_shadow_softness"}));
+        CHECK(Found(index, "shadow").size() == 5);
+    }
+}
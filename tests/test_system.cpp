@@ -1,5 +1,35 @@
 #include "doctest.h"
 #include "csys/system.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Allocation counter of the testing thread, only counts while enabled.
+static thread_local size_t s_Allocations = 0;
+static thread_local bool s_CountAllocations = false;
+
+static void *Allocate(std::size_t size)
+{
+    if (s_CountAllocations)
+        ++s_Allocations;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size) { return Allocate(size); }
+void *operator new[](std::size_t size) { return Allocate(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
 
 void setter(float& v, const float &r) { v = r; }
 
@@ -30,23 +60,551 @@ TEST_CASE ("Test CSYS System Class")
     temp.RegisterVariable("time_set", time_variable, setter);
 
     temp.RunCommand("set time_set 30");
-    CHECK(time_variable == 30);
+    CHECK(time_variable == 30.f);
 
     // Modification.
     temp.RunCommand("set time 10");
-    CHECK(time_variable == 10);
+    CHECK(time_variable == 10.f);
     temp.RunCommand("set time 15");
-    CHECK(time_variable == 15);
+    CHECK(time_variable == 15.f);
     temp.RunCommand("set temp_var 30");
     CHECK(temp_var == 30);
 
     // Test system variables.
     temp.UnregisterVariable("time");
     temp.RunCommand("set time 10");
-    CHECK(time_variable == 15);
+    CHECK(time_variable == 15.f);
 
     // Test system commands.
     temp.UnregisterCommand("test");
     temp.RunCommand("test false");
     CHECK(test_flag);
-}
\ No newline at end of file
+}
+TEST_CASE ("Test CSYS System Compiled Commands")
+{
+    csys::System temp;
+
+    int sum = 0;
+    temp.RegisterCommand("add", "Adds to sum", [&sum](int a, int b) { sum += a + b; }, csys::Arg<int>("a"), csys::Arg<int>("b"));
+    float var = 0;
+    temp.RegisterVariable("var", var, csys::Arg<float>(""));
+
+    // Compile once, run many times.
+    auto add = temp.Compile("add 1 2");
+    CHECK(add.Valid());
+    CHECK(add.Line() == "add 1 2");
+    temp.Run(add);
+    temp.Run(add);
+    CHECK(sum == 6);
+    CHECK(temp.Items().back().m_Type == csys::COMMAND);
+
+    auto set = temp.Compile("set var 4.5");
+    CHECK(set.Valid());
+    temp.Run(set);
+    CHECK(var == 4.5f);
+
+    // Failed compilation.
+    size_t items = temp.Items().size();
+    CHECK(!temp.Compile("add 1").Valid());
+    CHECK(!temp.Compile("missing").Valid());
+    CHECK(!temp.Compile("   ").Valid());
+    CHECK(temp.Items().size() == items + 2);
+
+    // Handles are invalidated when their target is removed.
+    temp.UnregisterCommand("add");
+    CHECK(!add.Valid());
+    temp.Run(add);
+    CHECK(sum == 6);
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+
+    temp.UnregisterVariable("var");
+    CHECK(!set.Valid());
+    var = 0;
+    temp.Run(set);
+    CHECK(var == 0.f);
+
+    // Re-registering does not revive old handles.
+    temp.RegisterCommand("add", "Adds to sum", [&sum](int a, int b) { sum -= a + b; }, csys::Arg<int>("a"), csys::Arg<int>("b"));
+    CHECK(!add.Valid());
+}
+
+TEST_CASE ("Test CSYS System Reentrant Commands")
+{
+    // A command running itself keeps its own arguments.
+    SUBCASE("Recursive command")
+    {
+        csys::System temp;
+        std::vector<std::string> seen;
+        temp.RegisterCommand("nest", "Runs itself n times", [&](int n, const csys::String &tag)
+        {
+            if (n > 0)
+                temp.RunCommand("nest " + std::to_string(n - 1) + " inner" + std::to_string(n));
+            seen.push_back(tag.m_String + ":" + std::to_string(n));
+        }, csys::Arg<int>("n"), csys::Arg<csys::String>("tag"));
+
+        temp.RunCommand("nest 2 outer");
+        CHECK(seen == std::vector<std::string>{"inner1:0", "inner2:1", "outer:2"});
+    }
+
+    // One command object parsing and running on several threads at once.
+    SUBCASE("Concurrent command")
+    {
+        constexpr int threads = 4, runs = 500;
+        std::atomic<int> wrong{0};
+        auto sum = [&wrong](int id, const std::vector<int> &values)
+        {
+            for (int value : values)
+                if (value != id)
+                    ++wrong;
+        };
+        const csys::Command<decltype(sum), csys::Arg<int>, csys::Arg<std::vector<int>>>
+                command("sum", "Checks values", sum, csys::Arg<int>("id"), csys::Arg<std::vector<int>>("values"));
+
+        std::vector<std::thread> workers;
+        for (int id = 0; id < threads; ++id)
+            workers.emplace_back([&command, id]()
+            {
+                std::string line = std::to_string(id) + " [";
+                for (int i = 0; i < 64; ++i)
+                    line += std::to_string(id) + " ";
+                line += "]";
+                for (int i = 0; i < runs; ++i)
+                    command(line);
+            });
+        for (auto &worker : workers)
+            worker.join();
+        CHECK(wrong == 0);
+    }
+}
+
+TEST_CASE ("Test CSYS System Command Functions")
+{
+    csys::System temp;
+
+    // Mutable lambdas keep their state between calls.
+    int last = 0;
+    temp.RegisterCommand("count", "Counts calls", [&last, calls = 0]() mutable { last = ++calls; });
+    temp.RunCommand("count");
+    temp.RunCommand("count");
+    CHECK(last == 2);
+
+    // Arguments taken by value may be moved from, compiled arguments are copied every run.
+    std::vector<std::string> seen;
+    temp.RegisterCommand("take", "Takes its arguments", [&seen](std::string str, std::vector<int> values)
+    {
+        seen.push_back(std::move(str) + ":" + std::to_string(values.size()));
+    }, csys::Arg<csys::String>("str"), csys::Arg<std::vector<int>>("values"));
+    temp.RunCommand("take now [1 2]");
+    auto take = temp.Compile("take later [1 2 3]");
+    temp.Run(take);
+    temp.Run(take);
+    CHECK(seen == std::vector<std::string>{"now:2", "later:3", "later:3"});
+
+    // A csys::Exception thrown by the function is logged as an error of the command.
+    temp.RegisterCommand("fail", "Throws", [](int) { throw csys::Exception("broken"); }, csys::Arg<int>("n"));
+    temp.RunCommand("fail 1");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Data == "fail: broken");
+    auto fail = temp.Compile("fail 2");
+    temp.Run(fail);
+    CHECK(temp.Items().back().m_Data == "fail: broken");
+}
+
+TEST_CASE ("Test CSYS System Dispatch Allocations")
+{
+    csys::System temp;
+
+    int value = 0;
+    float var = 0;
+    temp.RegisterCommand("noop", "Does nothing", [&value]() { ++value; });
+    temp.RegisterCommand("add", "Adds to value", [&value](int a, int b) { value += a + b; }, csys::Arg<int>("a"), csys::Arg<int>("b"));
+    temp.RegisterVariable("var", var, csys::Arg<float>(""));
+
+    // Log storage and the hit counters allocated by the first hits are not part of dispatch.
+    temp.Items().reserve(64);
+    temp.RunCommand("noop");
+    temp.RunCommand("set var 1");
+
+    auto count = [&temp](const std::string &line)
+    {
+        s_Allocations = 0;
+        s_CountAllocations = true;
+        temp.RunCommand(line);
+        s_CountAllocations = false;
+        return s_Allocations;
+    };
+
+    CHECK(count("noop") == 0);
+    CHECK(count("add 1 2") == 0);
+    CHECK(count("set var 2") == 0);
+    CHECK(count("help noop") > 0); // Help builds its output string.
+    CHECK(value == 5);
+    CHECK(var == 2.f);
+}
+
+TEST_CASE ("Test CSYS System Freeze")
+{
+    csys::System temp;
+
+    int value = 0;
+    float var = 0;
+    for (int i = 0; i < 100; ++i)
+        temp.RegisterCommand("cmd_" + std::to_string(i), "", [&value, i]() { value = i; });
+    temp.RegisterVariable("var", var, csys::Arg<float>(""));
+
+    CHECK(!temp.Frozen());
+    temp.Freeze();
+    CHECK(temp.Frozen());
+
+    // Every kind of command resolves through the frozen table.
+    temp.RunCommand("cmd_42");
+    CHECK(value == 42);
+    temp.RunCommand("set var 3");
+    CHECK(var == 3.f);
+    size_t items = temp.Items().size();
+    temp.RunCommand("help cmd_7");
+    CHECK(temp.Items().size() == items + 2);
+    CHECK(temp.Items().back().m_Type == csys::LOG);
+    temp.RunCommand("cmd_100");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+
+    // Copies stay frozen.
+    csys::System copy(temp);
+    CHECK(copy.Frozen());
+
+    // Registration thaws.
+    temp.UnregisterCommand("cmd_42");
+    CHECK(!temp.Frozen());
+    temp.RunCommand("cmd_42");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    temp.Freeze();
+    temp.RegisterCommand("late", "", [&value]() { value = -1; });
+    CHECK(!temp.Frozen());
+    temp.RunCommand("late");
+    CHECK(value == -1);
+}
+
+TEST_CASE ("Test CSYS System Variables")
+{
+    csys::System temp;
+
+    float var = 0;
+    temp.RegisterVariable("var", var, csys::Arg<float>(""));
+    CHECK(temp.Variables().size() == 1);
+    CHECK(temp.Commands().find(csys::CommandKeyView{csys::CommandVerb::SET, "var"}) == temp.Commands().end());
+
+    // Get logs value.
+    temp.RunCommand("set var 2.5");
+    temp.RunCommand("get var");
+    CHECK(temp.Items().back().m_Type == csys::LOG);
+    CHECK(temp.Items().back().m_Data == std::to_string(2.5f) + "\n");
+
+    // Errors are prefixed with verb and name.
+    temp.RunCommand("set var");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Data.rfind("set var: ", 0) == 0);
+    temp.RunCommand("get var 1");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Data.rfind("get var: ", 0) == 0);
+    CHECK(!temp.Compile("get var 1").Valid());
+    CHECK(var == 2.5f);
+
+    // Copies share storage.
+    csys::System copy(temp);
+    copy.RunCommand("set var 4");
+    CHECK(var == 4.f);
+
+    temp.UnregisterVariable("var");
+    CHECK(temp.Variables().empty());
+    temp.RunCommand("get var");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+}
+
+TEST_CASE ("Test CSYS System Did You Mean")
+{
+    csys::System temp;
+
+    int fov = 0, sensitivity = 0;
+    temp.RegisterCommand("reload_shaders", "", []() {});
+    temp.RegisterVariable("fov", fov, csys::Arg<int>(""));
+    temp.RegisterVariable("sensitivity", sensitivity, csys::Arg<int>(""));
+
+    // Misspelled command.
+    temp.RunCommand("relaod_shaders");
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Data.find("did you mean \"reload_shaders\"?") != std::string::npos);
+
+    // Misspelled variable.
+    temp.RunCommand("set sensitivty 2");
+    CHECK(temp.Items().back().m_Data.find("did you mean \"sensitivity\"?") != std::string::npos);
+
+    // Nothing close.
+    temp.RunCommand("get zzzzzz");
+    CHECK(temp.Items().back().m_Data.find("did you mean") == std::string::npos);
+    // At most two typos, even on long names.
+    temp.RunCommand("xeloax_shaderx");
+    CHECK(temp.Items().back().m_Data.find("did you mean") == std::string::npos);
+
+    // Batches only suggest when asked to.
+    std::vector<std::string> lines({"relaod_shaders"});
+    csys::BatchOptions options;
+    temp.RunBatch(lines, options);
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Data.find("did you mean") == std::string::npos);
+    options.m_Suggestions = true;
+    temp.RunBatch(lines, options);
+    CHECK(temp.Items().back().m_Data.find("did you mean \"reload_shaders\"?") != std::string::npos);
+}
+
+TEST_CASE ("Test CSYS System Ranked History")
+{
+    csys::System temp;
+    float var = 0;
+    temp.RegisterCommand("reload", "Does nothing", []() {});
+    temp.RegisterCommand("restart", "Does nothing", []() {});
+    temp.RegisterCommand("add", "Does nothing", [](int) {}, csys::Arg<int>("a"));
+    temp.RegisterVariable("rate", var, csys::Arg<float>(""));
+
+    // Successful dispatches are counted.
+    temp.RunCommand("restart");
+    temp.RunCommand("restart");
+    temp.RunCommand("reload");
+    temp.RunCommand("add x");
+    temp.RunCommand("set rate 2");
+    CHECK(temp.CmdAutocomplete().Hits("restart") == 2);
+    CHECK(temp.CmdAutocomplete().Hits("add") == 0);
+    CHECK(temp.CmdAutocomplete().Hits("set") == 1);
+    CHECK(temp.VarAutocomplete().Hits("rate") == 1);
+
+    std::vector<std::string> ranked;
+    temp.CmdAutocomplete().RankedSuggestions("re", 5, ranked);
+    CHECK(ranked == std::vector<std::string>({"restart", "reload"}));
+
+    // Counters are saved and loaded along with the history.
+    const char *path = "temp_history.txt";
+    REQUIRE(temp.SaveHistory(path));
+
+    csys::System loaded;
+    loaded.RegisterCommand("reload", "Does nothing", []() {});
+    loaded.RegisterCommand("restart", "Does nothing", []() {});
+    loaded.RegisterVariable("rate", var, csys::Arg<float>(""));
+    REQUIRE(loaded.LoadHistory(path));
+    CHECK(loaded.CmdAutocomplete().Hits("restart") == 2);
+    CHECK(loaded.CmdAutocomplete().Hits("reload") == 1);
+    CHECK(loaded.VarAutocomplete().Hits("rate") == 1);
+    CHECK(loaded.History().Size() == temp.History().Size());
+    CHECK(loaded.History().GetNew() == "set rate 2");
+    CHECK(loaded.History().GetOld() == "restart");
+
+    // Line breaks and backslashes survive a round trip.
+    const std::string multiline = "echo first\nsecond \\n \\\r\nthird\\";
+    loaded.History().PushBack(multiline);
+    REQUIRE(loaded.SaveHistory(path));
+    csys::System reloaded;
+    REQUIRE(reloaded.LoadHistory(path));
+    CHECK(reloaded.History().Size() == loaded.History().Size());
+    CHECK(reloaded.History().GetNew() == multiline);
+    CHECK(reloaded.History().GetOld() == "restart");
+
+    // Plain history seeds the counters.
+    {
+        std::ofstream file(path);
+        file << "reload\nreload\n  \nget rate\nmissing\n";
+    }
+    csys::System seeded;
+    seeded.RegisterCommand("reload", "Does nothing", []() {});
+    seeded.RegisterVariable("rate", var, csys::Arg<float>(""));
+    REQUIRE(seeded.LoadHistory(path));
+    CHECK(seeded.CmdAutocomplete().Hits("reload") == 2);
+    CHECK(seeded.CmdAutocomplete().Hits("get") == 1);
+    CHECK(seeded.VarAutocomplete().Hits("rate") == 1);
+    CHECK(seeded.History().Size() == 4);
+    std::remove(path);
+
+    CHECK(!seeded.LoadHistory("missing_history.txt"));
+}
+
+TEST_CASE ("Test CSYS System Search")
+{
+    csys::System temp;
+    float quality = 0, bias = 0;
+    temp.RegisterCommand("reload_shaders", "Does nothing", []() {});
+    temp.RegisterVariable("r_shadow_quality", quality, csys::Arg<float>(""));
+    temp.RegisterVariable("r_shadow_bias", bias, csys::Arg<float>(""));
+
+    CHECK(temp.Search("shadow") == std::vector<std::string>({"r_shadow_bias", "r_shadow_quality"}));
+    CHECK(temp.Search("shad") == std::vector<std::string>({"r_shadow_bias", "r_shadow_quality", "reload_shaders"}));
+    CHECK(temp.Search("SHADER") == std::vector<std::string>({"reload_shaders"}));
+    CHECK(temp.Search("shad", 1).size() == 1);
+
+    // Kept in sync with registration.
+    temp.UnregisterVariable("r_shadow_bias");
+    temp.UnregisterCommand("reload_shaders");
+    CHECK(temp.Search("sha") == std::vector<std::string>({"r_shadow_quality"}));
+
+    csys::System copy(temp);
+    CHECK(copy.Search("quality") == std::vector<std::string>({"r_shadow_quality"}));
+}
+
+TEST_CASE ("Test CSYS System Line Completion")
+{
+    csys::System temp;
+    bool vsync = false;
+    float gamma = 0;
+    temp.RegisterCommand("fullscreen", "Does nothing", [](bool, int) {}, csys::Arg<bool>("on"), csys::Arg<int>("monitor"));
+    temp.RegisterCommand("fov", "Does nothing", [](float) {}, csys::Arg<float>("degrees"));
+    temp.RegisterVariable("r_vsync", vsync, csys::Arg<bool>(""));
+    temp.RegisterVariable("r_gamma", gamma, csys::Arg<float>(""));
+
+    auto Complete = [&temp](std::string_view line, size_t cursor = std::string_view::npos)
+    {
+        return temp.Complete(line, cursor == std::string_view::npos ? line.size() : cursor);
+    };
+
+    // Command names, most used first.
+    auto completion = Complete("f");
+    CHECK(completion.m_Context == csys::CompletionContext::COMMAND);
+    CHECK(completion.m_Options == std::vector<std::string>({"fov", "fullscreen"}));
+    temp.RunCommand("fullscreen true 0");
+    CHECK(Complete("f").m_Options == std::vector<std::string>({"fullscreen", "fov"}));
+
+    // Replacement range covers the whole token around the cursor.
+    completion = Complete("  fulls x", 4);
+    CHECK(completion.m_Begin == 2);
+    CHECK(completion.m_End == 7);
+    CHECK(completion.m_Options == std::vector<std::string>({"fullscreen"}));
+
+    // Variables only after set and get, commands only after help.
+    completion = Complete("set r_");
+    CHECK(completion.m_Context == csys::CompletionContext::VARIABLE);
+    CHECK(completion.m_Begin == 4);
+    CHECK(completion.m_Options == std::vector<std::string>({"r_gamma", "r_vsync"}));
+    CHECK(Complete("get ").m_Options == std::vector<std::string>({"r_gamma", "r_vsync"}));
+    CHECK(Complete("set f").m_Options.empty());
+    completion = Complete("help f");
+    CHECK(completion.m_Context == csys::CompletionContext::HELP);
+    CHECK(completion.m_Options == std::vector<std::string>({"fullscreen", "fov"}));
+    CHECK(Complete("help s").m_Options.empty());
+
+    // Boolean arguments of commands and sets.
+    completion = Complete("fullscreen ");
+    CHECK(completion.m_Context == csys::CompletionContext::BOOLEAN);
+    CHECK(completion.m_Options == std::vector<std::string>({"true", "false"}));
+    CHECK(Complete("fullscreen F").m_Options == std::vector<std::string>({"false"}));
+    CHECK(Complete("set r_vsync t").m_Options == std::vector<std::string>({"true"}));
+    bool flag = false;
+    temp.RegisterVariable("ref_flag", flag, +[](bool &var, const bool &value) { var = value; });
+    CHECK(Complete("set ref_flag t").m_Options == std::vector<std::string>({"true"}));
+    CHECK(Complete("fullscreen true ").m_Context == csys::CompletionContext::NONE);
+    CHECK(Complete("fov ").m_Context == csys::CompletionContext::NONE);
+    CHECK(Complete("set r_gamma ").m_Context == csys::CompletionContext::NONE);
+    CHECK(Complete("get r_vsync ").m_Context == csys::CompletionContext::NONE);
+    CHECK(Complete("nothing ").m_Context == csys::CompletionContext::NONE);
+
+    // Quoted strings and vectors are a single argument.
+    temp.RegisterCommand("bind", "Does nothing", [](csys::String, bool) {}, csys::Arg<csys::String>("key"),
+                         csys::Arg<bool>("hold"));
+    CHECK(Complete("bind \"a b\" ").m_Options == std::vector<std::string>({"true", "false"}));
+    CHECK(Complete("bind \"a ").m_Context == csys::CompletionContext::NONE);
+
+    // Empty line.
+    completion = Complete("", 5);
+    CHECK(completion.m_Begin == 0);
+    CHECK(completion.m_End == 0);
+    CHECK(completion.m_Options.size() == 6);
+}
+
+TEST_CASE ("Test CSYS System Batch")
+{
+    csys::System temp;
+
+    int sum = 0;
+    temp.RegisterCommand("add", "Adds to sum", [&sum](int a, int b) { sum += a + b; }, csys::Arg<int>("a"), csys::Arg<int>("b"));
+    float var = 0;
+    temp.RegisterVariable("var", var, csys::Arg<float>(""));
+
+    std::vector<std::string> lines = {"add 1 2", "   ", "set var 3", "add 1", "missing", "add 3 4"};
+    size_t items = temp.Items().size();
+    size_t history = temp.History().Size();
+
+    // Quiet batch, only errors are logged and one history entry is recorded.
+    csys::BatchOptions options;
+    options.m_HistoryEntry = "config";
+    auto status = temp.RunBatch(lines, options);
+    REQUIRE(status.size() == lines.size());
+    CHECK(status[0] == csys::CommandStatus::SUCCESS);
+    CHECK(status[1] == csys::CommandStatus::EMPTY);
+    CHECK(status[2] == csys::CommandStatus::SUCCESS);
+    CHECK(status[3] == csys::CommandStatus::ERROR);
+    CHECK(status[4] == csys::CommandStatus::ERROR);
+    CHECK(status[5] == csys::CommandStatus::SUCCESS);
+    CHECK(sum == 10);
+    CHECK(var == 3.f);
+    CHECK(temp.Items().size() == items + 2);
+    CHECK(temp.History().Size() == history + 1);
+    CHECK(temp.History().GetNew() == "config");
+
+    // Echoed batch behaves like RunCommand.
+    std::string_view views[] = {"add 1 1", "get var"};
+    options = csys::BatchOptions();
+    options.m_Echo = true;
+    options.m_LineHistory = true;
+    items = temp.Items().size();
+    history = temp.History().Size();
+    status = temp.RunBatch(views, 2, options);
+    CHECK(status[0] == csys::CommandStatus::SUCCESS);
+    CHECK(status[1] == csys::CommandStatus::SUCCESS);
+    CHECK(sum == 12);
+    CHECK(temp.Items().size() == items + 3);
+    CHECK(temp.History().Size() == history + 2);
+}
+
+TEST_CASE ("Test CSYS System Async Commands")
+{
+    csys::System temp;
+    temp.CreateThreadPool(2);
+
+    std::atomic<int> sum(0);
+    temp.RegisterCommand(csys::Async(), "slow_add", "Adds to sum on a worker", [&sum](int a, int b)
+    {
+        sum += a + b;
+        return csys::Item(csys::LOG) << "added " << std::to_string(a + b);
+    }, csys::Arg<int>("a"), csys::Arg<int>("b"));
+    temp.RegisterCommand("add", "Adds to sum", [&sum](int a) { sum += a; }, csys::Arg<int>("a"));
+
+    // Output comes back through the future, and is logged on poll.
+    auto result = temp.RunCommandAsync("slow_add 1 2");
+    auto item = result.get();
+    CHECK(sum == 3);
+    CHECK(item.m_Type == csys::LOG);
+    CHECK(item.m_Data == "added 3");
+    size_t items = temp.Items().size();
+    CHECK(temp.PollAsync() == 1);
+    CHECK(temp.Items().size() == items + 1);
+    CHECK(temp.Items().back().m_Data == "added 3");
+
+    // Parse errors come back right away.
+    result = temp.RunCommandAsync("slow_add 1");
+    CHECK(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    CHECK(result.get().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+
+    // Other commands run right away.
+    CHECK(temp.RunCommandAsync("add 4").get().m_Type == csys::NONE);
+    CHECK(sum == 7);
+
+    // RunCommand does not wait either.
+    temp.RunCommand("slow_add 5 5");
+    temp.CreateThreadPool(1);
+    CHECK(sum == 17);
+    CHECK(temp.PollAsync() == 1);
+    // Exceptions are logged on poll when nobody waits on the future.
+    temp.RegisterCommand(csys::Async(), "throw", "Throws on a worker", []() { throw std::runtime_error("broken"); });
+    temp.RunCommand("throw");
+    temp.CreateThreadPool(1);
+    CHECK(temp.PollAsync() == 1);
+    CHECK(temp.Items().back().m_Type == csys::ERROR);
+    CHECK(temp.Items().back().m_Data == "throw: broken");
+    CHECK_THROWS_AS(temp.RunCommandAsync("throw").get(), std::runtime_error);
+    CHECK(temp.PollAsync() == 0);
+}